@@ -0,0 +1,58 @@
+#pragma once
+
+#include <flow/details.h>
+#include <flow/Maybe.h>
+
+namespace flow
+{
+    namespace details
+    {
+        template<class S, class = void>
+        struct HasAdvanceBy: std::false_type
+        {
+        };
+
+        template<class S>
+        struct HasAdvanceBy<S, std::void_t<decltype(std::declval<S &>().advanceBy(size_t()))>>: std::true_type
+        {
+        };
+
+        /// Whether the sequence can skip elements without producing them first.
+        template<class S>
+        static constexpr bool hasAdvanceBy = HasAdvanceBy<S>::value;
+    }
+
+    /// Skips up to `n` elements of the sequence.
+    /// Returns the number of elements actually skipped, which is less than `n` only if the sequence got exhausted.
+    /// Sequences which do not implement `advanceBy()` are advanced by discarding elements returned by `next()`.
+    template<class S>
+    size_t advanceBy(S &sequence, size_t n)
+    {
+        if constexpr (details::hasAdvanceBy<S>)
+        {
+            return sequence.advanceBy(n);
+        }
+        else
+        {
+            for (size_t k = 0; k < n; ++k)
+            {
+                if (!sequence.next().hasValue())
+                {
+                    return k;
+                }
+            }
+            return n;
+        }
+    }
+
+    /// Skips `n` elements and returns the next one, i.e. the `n`-th element counting from zero.
+    template<class S>
+    Maybe<typename S::ElementType> nth(S &sequence, size_t n)
+    {
+        if (advanceBy(sequence, n) < n)
+        {
+            return None();
+        }
+        return sequence.next();
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+
+#include <flow/details.h>
+#include <flow/Maybe.h>
+#include <flow/Span.h>
+
+namespace flow
+{
+    namespace details
+    {
+        /// The amount of elements adapters buffer on the stack while processing a batch.
+        static constexpr size_t batchSize = 64;
+
+        /// Elements can only be pulled in batches if they can be stored in a pre-allocated buffer.
+        template<class T>
+        static constexpr bool isBatchable = !std::is_reference_v<T>
+            && std::is_default_constructible_v<T>
+            && std::is_move_assignable_v<T>;
+
+        template<class S, class = void>
+        struct HasNextBatch: std::false_type
+        {
+        };
+
+        template<class S>
+        struct HasNextBatch<S, std::void_t<decltype(std::declval<S &>().nextBatch(
+            std::declval<Span<typename S::ElementType>>()))>>: std::true_type
+        {
+        };
+
+        /// Whether the sequence implements the batch protocol itself,
+        /// as opposed to falling back to consecutive calls to `next()`.
+        /// Sequences yielding elements which cannot be batched are never probed.
+        template<class S>
+        static constexpr bool hasNextBatch = std::conjunction_v<
+            std::bool_constant<isBatchable<typename S::ElementType>>,
+            HasNextBatch<S>>;
+    }
+
+    /// Pulls up to `batch.size()` elements out of the sequence into the given batch.
+    /// Returns the number of elements written to the front of the batch.
+    /// Fewer elements than requested may be written even if the sequence is not exhausted yet,
+    /// but zero elements are only written if the sequence is exhausted or the batch is empty.
+    /// Sequences which do not implement `nextBatch()` are drained by calling `next()` repeatedly.
+    template<class S>
+    size_t nextBatch(S &sequence, Span<typename S::ElementType> batch)
+    {
+        if constexpr (details::hasNextBatch<S>)
+        {
+            return sequence.nextBatch(batch);
+        }
+        else
+        {
+            size_t count = 0;
+            while (count < batch.size())
+            {
+                Maybe<typename S::ElementType> nextElement = sequence.next();
+                if (!nextElement.hasValue())
+                {
+                    break;
+                }
+                batch[count++] = std::move(nextElement.value());
+            }
+            return count;
+        }
+    }
+}
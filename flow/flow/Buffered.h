@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <flow/details.h>
+#include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+
+namespace flow
+{
+    /// Wait policy of `buffered`, putting the waiting thread to sleep until the other thread makes progress.
+    /// Notifying is free as long as no thread is waiting.
+    class BlockingWait
+    {
+    public:
+        template<class P>
+        void waitUntil(P const &isReady)
+        {
+            if (isReady())
+            {
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            waiting.store(true, std::memory_order_relaxed);
+            // Either the waiting flag is seen by the notifying thread, or the progress is seen here.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            condition.wait(lock, isReady);
+            waiting.store(false, std::memory_order_relaxed);
+        }
+
+        void notify()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting.load(std::memory_order_relaxed))
+            {
+                {
+                    // Wait until the waiting thread sleeps, so that it does not miss the notification.
+                    std::lock_guard<std::mutex> lock(mutex);
+                }
+                condition.notify_one();
+            }
+        }
+
+    private:
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::atomic<bool> waiting = false;
+    };
+
+    /// Wait policy of `buffered`, busy waiting for the other thread to make progress.
+    /// This minimizes latency at the cost of occupying a core while waiting.
+    class SpinningWait
+    {
+    public:
+        template<class P>
+        void waitUntil(P const &isReady)
+        {
+            for (size_t spins = 0; !isReady(); ++spins)
+            {
+                if (spins >= 1024)
+                {
+                    // Give other threads, e.g. the one to wait for, a chance if the cores are oversubscribed.
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        void notify()
+        {
+        }
+    };
+
+    namespace details
+    {
+        /// A bounded single-producer single-consumer ring buffer, filled by a thread iterating the base sequence.
+        template<class S, class W>
+        struct BufferedState
+        {
+            using ElementType = typename S::ElementType;
+
+            BufferedState(S &&sequence, size_t capacity):
+                sequence(std::move(sequence)),
+                ring(capacity, Maybe<ElementType>(None()))
+            {
+            }
+
+            ~BufferedState()
+            {
+                if (producer.joinable())
+                {
+                    cancelled.store(true, std::memory_order_relaxed);
+                    notFull.notify();
+                    producer.join();
+                }
+            }
+
+            void produce()
+            {
+                try
+                {
+                    for (Maybe<ElementType> element = sequence.next(); element.hasValue(); element = sequence.next())
+                    {
+                        size_t t = tail.load(std::memory_order_relaxed);
+                        notFull.waitUntil([&]
+                        {
+                            return cancelled.load(std::memory_order_relaxed)
+                                || t - head.load(std::memory_order_acquire) < ring.size();
+                        });
+                        if (cancelled.load(std::memory_order_relaxed))
+                        {
+                            break;
+                        }
+                        details::reinitialize(ring[t % ring.size()], std::move(element));
+                        tail.store(t + 1, std::memory_order_release);
+                        notEmpty.notify();
+                    }
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                finished.store(true, std::memory_order_release);
+                notEmpty.notify();
+            }
+
+            Maybe<ElementType> consume()
+            {
+                size_t h = head.load(std::memory_order_relaxed);
+                notEmpty.waitUntil([&]
+                {
+                    return tail.load(std::memory_order_acquire) != h || finished.load(std::memory_order_acquire);
+                });
+
+                if (tail.load(std::memory_order_acquire) == h)
+                {
+                    // The producer is done and all elements are consumed.
+                    if (error)
+                    {
+                        std::rethrow_exception(std::exchange(error, nullptr));
+                    }
+                    return None();
+                }
+
+                Maybe<ElementType> element(std::move(ring[h % ring.size()]));
+                head.store(h + 1, std::memory_order_release);
+                notFull.notify();
+                return element;
+            }
+
+            S sequence;
+            std::vector<Maybe<ElementType>> ring;
+
+            /// Counts consumed elements, written by the consumer only.
+            /// Both counters live on different cache lines, so that both threads do not contend for the same one.
+            alignas(64) std::atomic<size_t> head = 0;
+
+            /// Counts produced elements, written by the producer only.
+            alignas(64) std::atomic<size_t> tail = 0;
+
+            alignas(64) std::atomic<bool> finished = false;
+            std::atomic<bool> cancelled = false;
+            std::exception_ptr error;
+            W notEmpty;
+            W notFull;
+            std::thread producer;
+        };
+    }
+
+    /// Iterates the base sequence on a dedicated thread, which buffers up to a fixed number of elements ahead.
+    /// This lets the base sequence, e.g. an I/O-bound `generate`, overlap with the work done by the consumer.
+    /// The thread is started once this sequence is iterated, so copy it before iterating.
+    /// When this sequence is dropped, the thread stops after the element it is currently pulling.
+    /// Exceptions thrown by the base sequence are rethrown after all elements pulled before are consumed.
+    /// Arity: 1 -> 1
+    template<class S, class W = BlockingWait>
+    class Buffered
+    {
+    public:
+        using ElementType = typename S::ElementType;
+
+        static_assert(!std::is_reference_v<ElementType>, "Buffered elements must be owned.");
+
+        Buffered(S &&sequence, size_t capacity):
+            state(std::make_unique<details::BufferedState<S, W>>(std::move(sequence), std::max(capacity, size_t(1))))
+        {
+        }
+
+        Buffered(Buffered const &other):
+            state(std::make_unique<details::BufferedState<S, W>>(S(other.state->sequence), other.state->ring.size()))
+        {
+        }
+
+        Buffered(Buffered &&other) = default;
+
+        Maybe<ElementType> next()
+        {
+            if (!started)
+            {
+                started = true;
+                state->producer = std::thread([state = state.get()] { state->produce(); });
+            }
+            return state->consume();
+        }
+
+        /// Once the base sequence is iterated by the thread, the number of remaining elements is unknown.
+        SizeHint sizeHint() const
+        {
+            return started ? SizeHint::unknown() : flow::sizeHint(state->sequence);
+        }
+
+    private:
+        std::unique_ptr<details::BufferedState<S, W>> state;
+        bool started = false;
+    };
+
+    /// Buffers up to `capacity` elements, waiting by the given policy, e.g. `buffered<SpinningWait>(64)`.
+    template<class W = BlockingWait>
+    auto buffered(size_t capacity)
+    {
+        return [=] (auto &&sequence)
+        {
+            using S = std::remove_reference_t<decltype(sequence)>;
+            return Buffered<S, W>(std::move(sequence), capacity);
+        };
+    }
+}
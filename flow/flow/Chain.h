@@ -1,6 +1,11 @@
 #pragma once
 
+#include <flow/Advance.h>
+#include <flow/Batch.h>
 #include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/Slice.h>
+#include <flow/TryFold.h>
 
 namespace flow
 {
@@ -15,6 +20,8 @@ namespace flow
     {
     public:
         using ElementType = typename D::ElementType;
+
+        static constexpr bool isExactlySliceable = details::isExactlySliceable<D> && details::isExactlySliceable<C>;
         
         explicit Chain(D &&drainingSequence, C &&continuationSequence):
             drainingSequence(std::move(drainingSequence)),
@@ -61,6 +68,126 @@ namespace flow
             return continuationSequence.next();
         }
 
+        size_t nextBatch(Span<ElementType> batch)
+        {
+            if (draining)
+            {
+                size_t count = flow::nextBatch(drainingSequence, batch);
+                if (count > 0)
+                {
+                    return count;
+                }
+                draining = false;
+            }
+
+            if constexpr (std::is_same_v<typename C::ElementType, ElementType>)
+            {
+                return flow::nextBatch(continuationSequence, batch);
+            }
+            else
+            {
+                // Continuation elements must be converted one by one.
+                size_t count = 0;
+                while (count < batch.size())
+                {
+                    Maybe<typename C::ElementType> nextElement = continuationSequence.next();
+                    if (!nextElement.hasValue())
+                    {
+                        break;
+                    }
+                    batch[count++] = std::move(nextElement.value());
+                }
+                return count;
+            }
+        }
+
+        size_t advanceBy(size_t n)
+        {
+            size_t skipped = 0;
+            if (draining)
+            {
+                skipped = flow::advanceBy(drainingSequence, n);
+                if (skipped == n)
+                {
+                    return n;
+                }
+                draining = false;
+            }
+            return skipped + flow::advanceBy(continuationSequence, n - skipped);
+        }
+
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            if (draining)
+            {
+                if (!flow::tryFold(drainingSequence, accumulator, function))
+                {
+                    return false;
+                }
+                draining = false;
+            }
+
+            using ContinuationType = typename C::ElementType;
+            return flow::tryFold(continuationSequence, accumulator, [&] (A &acc, ContinuationType &&element)
+            {
+                return function(acc, ElementType(std::forward<ContinuationType>(element)));
+            });
+        }
+
+        SizeHint sizeHint() const
+        {
+            SizeHint continuationHint = flow::sizeHint(continuationSequence);
+            if (!draining)
+            {
+                return continuationHint;
+            }
+
+            SizeHint drainingHint = flow::sizeHint(drainingSequence);
+            size_t lower = details::saturatingAdd(drainingHint.lower, continuationHint.lower);
+            if (drainingHint.upper.hasValue() && continuationHint.upper.hasValue())
+            {
+                size_t a = drainingHint.upper.value();
+                size_t b = continuationHint.upper.value();
+                if (a <= std::numeric_limits<size_t>::max() - b)
+                {
+                    return SizeHint{lower, a + b};
+                }
+            }
+            return SizeHint{lower, None()};
+        }
+
+        /// The positions of the continuation sequence follow the positions of the draining sequence.
+        template<
+            class A = D,
+            class B = C,
+            class = std::enable_if_t<details::isSliceable<A> && details::isSliceable<B>>>
+        Chain slice(size_t begin, size_t end) const
+        {
+            size_t seam = slicePositions(drainingSequence);
+            return Chain(
+                drainingSequence.slice(std::min(begin, seam), std::min(end, seam)),
+                continuationSequence.slice(begin - std::min(begin, seam), end - std::min(end, seam)));
+        }
+
+        /// Splits at the seam, so that each half only iterates one of both sequences.
+        /// If one of them is empty, the other one is split in the middle.
+        template<
+            class A = D,
+            class B = C,
+            class = std::enable_if_t<details::isSliceable<A> && details::isSliceable<B>>>
+        Maybe<std::pair<Chain, Chain>> split() const
+        {
+            size_t seam = slicePositions(drainingSequence);
+            size_t positions = seam + slicePositions(continuationSequence);
+            if (positions < 2)
+            {
+                return None();
+            }
+            size_t middle = seam > 0 && seam < positions ? seam : positions / 2;
+            return std::pair<Chain, Chain>(slice(0, middle), slice(middle, positions));
+        }
+
     private:
         D drainingSequence;
         C continuationSequence;
@@ -70,7 +197,8 @@ namespace flow
     template<class C>
     auto chain(C &&continuationSequence)
     {
-        return [=] (auto &&drainingSequence) mutable
+        // The continuation is moved into the constructor instead of being copied, so it may be move-only.
+        return [continuationSequence = std::forward<C>(continuationSequence)] (auto &&drainingSequence) mutable
         {
             return Chain(std::move(drainingSequence), std::move(continuationSequence));
         };
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <flow/Batch.h>
+#include <flow/details.h>
+#include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/TryFold.h>
+
+namespace flow
+{
+    namespace details
+    {
+        template<class C, class = void>
+        struct HasReserve: std::false_type
+        {
+        };
+
+        template<class C>
+        struct HasReserve<C, std::void_t<decltype(std::declval<C &>().reserve(size_t()))>>: std::true_type
+        {
+        };
+
+        template<class C, class = void>
+        struct HasPushBack: std::false_type
+        {
+        };
+
+        template<class C>
+        struct HasPushBack<C, std::void_t<decltype(std::declval<C &>().push_back(
+            std::declval<typename C::value_type>()))>>: std::true_type
+        {
+        };
+
+        /// Moves all remaining elements of the sequence to the end of the container.
+        /// Containers which support it are grown ahead by the sequence's lower size bound.
+        template<class C, class S>
+        void append(C &container, S &sequence)
+        {
+            if constexpr (HasReserve<C>::value)
+            {
+                container.reserve(saturatingAdd(container.size(), flow::sizeHint(sequence).lower));
+            }
+
+            using ElementType = typename S::ElementType;
+
+            if constexpr (std::is_trivially_copyable_v<ElementType> && details::hasNextBatch<S> && HasPushBack<C>::value)
+            {
+                // Blocks are appended at once, which lets vectorized adapters such as `filter(lessThan(x))` kick in.
+                ElementType block[batchSize];
+                while (size_t count = flow::nextBatch(sequence, Span<ElementType>(block)))
+                {
+                    container.insert(container.end(), block, block + count);
+                }
+            }
+            else
+            {
+                flow::tryFold(sequence, container, [] (C &container, ElementType &&element)
+                {
+                    if constexpr (HasPushBack<C>::value)
+                    {
+                        container.push_back(std::forward<ElementType>(element));
+                    }
+                    else
+                    {
+                        container.insert(container.end(), std::forward<ElementType>(element));
+                    }
+                    return true;
+                });
+            }
+        }
+    }
+
+    /// Collects all elements of the sequence into a new container of the given type,
+    /// e.g. `collect<std::string>(flow)`.
+    /// Like `fold`, the sequence is taken by value, so pass an rvalue to avoid copying the pipeline.
+    template<class C, class S>
+    C collect(S sequence)
+    {
+        C container;
+        details::append(container, sequence);
+        return container;
+    }
+
+    /// Collects all elements of the sequence into a new container instantiated with the element type,
+    /// e.g. `collect<std::vector>(flow)`.
+    template<template<class...> class C, class S>
+    auto collect(S sequence)
+    {
+        using ValueType = std::remove_cv_t<std::remove_reference_t<typename S::ElementType>>;
+        return collect<C<ValueType>>(std::move(sequence));
+    }
+
+    /// Replaces the contents of the given container with all elements of the sequence.
+    /// The capacity of the container is kept, so reusing a container across runs
+    /// does not allocate once it has grown large enough.
+    template<class S, class C>
+    C &collectInto(S sequence, C &container)
+    {
+        container.clear();
+        details::append(container, sequence);
+        return container;
+    }
+}
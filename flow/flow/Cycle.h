@@ -2,6 +2,7 @@
 
 #include <flow/details.h>
 #include <flow/Maybe.h>
+#include <flow/SizeHint.h>
 
 namespace flow
 {
@@ -40,6 +41,24 @@ namespace flow
                 return sequence.next();
             }
         }
+
+        /// A cycled sequence is infinite unless the base sequence is empty.
+        SizeHint sizeHint() const
+        {
+            SizeHint hint = flow::sizeHint(base);
+            if (hint.upper.hasValue() && hint.upper.value() == 0)
+            {
+                return SizeHint::exactly(0);
+            }
+            else if (hint.lower > 0)
+            {
+                return SizeHint::infinite();
+            }
+            else
+            {
+                return SizeHint::unknown();
+            }
+        }
         
     private:
         S base;
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <flow/Advance.h>
+#include <flow/Batch.h>
 #include <flow/Flow.h>
 #include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/Slice.h>
+#include <flow/TryFold.h>
 
 namespace flow
 {
@@ -17,6 +22,12 @@ namespace flow
         using ElementType = typename C::value_type;
         using IteratorType = typename C::iterator;
 
+        /// Containers exposing their storage with `data()` and random-access iterators are assumed to be contiguous.
+        static constexpr bool isContiguous = details::HasData<C>::value
+            && details::isRandomAccessIterator<IteratorType>;
+
+        static constexpr bool isExactlySliceable = true;
+
         explicit Elements(C const &container):
             container(container),
             iterator(this->container.begin()),
@@ -61,6 +72,93 @@ namespace flow
             }
         }
 
+        /// Moves whole blocks of elements out of the container.
+        size_t nextBatch(Span<ElementType> batch)
+        {
+            size_t count = 0;
+            for (; count < batch.size() && iterator != end; ++count, ++iterator)
+            {
+                batch[count] = std::move(*iterator);
+            }
+            return count;
+        }
+
+        /// Skips elements without moving them out of the container,
+        /// in constant time if the container's iterators are random-access.
+        size_t advanceBy(size_t n)
+        {
+            if constexpr (details::isRandomAccessIterator<IteratorType>)
+            {
+                size_t skipped = std::min(n, static_cast<size_t>(end - iterator));
+                iterator += skipped;
+                return skipped;
+            }
+            else
+            {
+                size_t skipped = 0;
+                for (; skipped < n && iterator != end; ++skipped)
+                {
+                    ++iterator;
+                }
+                return skipped;
+            }
+        }
+
+        /// Drives the iteration by a plain loop over the container.
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            while (iterator != end)
+            {
+                // Because we own the container, we can move elements out of it.
+                bool proceed = function(accumulator, ElementType(std::move(*iterator)));
+                ++iterator;
+                if (!proceed)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// The hint is exact if the container's iterators are random-access.
+        SizeHint sizeHint() const
+        {
+            if constexpr (details::isRandomAccessIterator<IteratorType>)
+            {
+                return SizeHint::exactly(static_cast<size_t>(end - iterator));
+            }
+            else
+            {
+                return SizeHint::unknown();
+            }
+        }
+
+        /// Returns a pointer to the first remaining element.
+        /// Only available if the container is contiguous.
+        auto data() const
+        {
+            return container.data() + (iterator - container.begin());
+        }
+
+        /// Returns the number of remaining elements.
+        /// Only available if the container is contiguous.
+        size_t size() const
+        {
+            return static_cast<size_t>(end - iterator);
+        }
+
+        /// Copies the elements at the given remaining positions into a new container.
+        /// Only available if the container's iterators are random-access
+        /// and the container can be constructed from an iterator range.
+        template<
+            class I = IteratorType,
+            class = std::enable_if_t<details::isRandomAccessIterator<I> && std::is_constructible_v<C, I, I>>>
+        Elements slice(size_t begin, size_t end) const
+        {
+            return Elements(C(iterator + begin, iterator + end));
+        }
+
     private:
         C container;
         IteratorType iterator;
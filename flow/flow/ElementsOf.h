@@ -0,0 +1,130 @@
+#pragma once
+
+#include <flow/Flow.h>
+#include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/Slice.h>
+#include <flow/Span.h>
+#include <flow/TryFold.h>
+
+namespace flow
+{
+    /// Yields copies of all elements of a borrowed contiguous range, without owning or copying the range itself.
+    /// The sequence is merely a pair of pointers and therefore trivially copyable.
+    /// Elements are yielded by value, so that they can be pulled in batches and reduced by vectorized kernels.
+    /// This suits cheap elements such as numbers; use `elementsReferenced` to iterate expensive elements without copying them.
+    /// Using this sequence beyond the lifetime of the range will yield dangling pointers.
+    /// Because the remaining elements are contiguous, kernels may process them as a raw pointer range
+    /// through `data()` and `size()`.
+    template<class T>
+    class ElementsOf
+    {
+    public:
+        using ElementType = T;
+
+        static constexpr bool isContiguous = true;
+        static constexpr bool isExactlySliceable = true;
+
+        explicit ElementsOf(Span<T const> span):
+            iterator(span.data()),
+            end(span.data() + span.size())
+        {
+        }
+
+        bool probe()
+        {
+            return iterator != end;
+        }
+
+        Maybe<ElementType> next()
+        {
+            if (iterator != end)
+            {
+                return *iterator++;
+            }
+            else
+            {
+                return None();
+            }
+        }
+
+        size_t nextBatch(Span<ElementType> batch)
+        {
+            size_t count = std::min(batch.size(), size());
+            std::copy(iterator, iterator + count, batch.data());
+            iterator += count;
+            return count;
+        }
+
+        size_t advanceBy(size_t n)
+        {
+            size_t skipped = std::min(n, size());
+            iterator += skipped;
+            return skipped;
+        }
+
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            while (iterator != end)
+            {
+                if (!function(accumulator, ElementType(*iterator++)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        SizeHint sizeHint() const
+        {
+            return SizeHint::exactly(size());
+        }
+
+        /// Returns a pointer to the first remaining element.
+        T const *data() const
+        {
+            return iterator;
+        }
+
+        /// Returns the number of remaining elements.
+        size_t size() const
+        {
+            return static_cast<size_t>(end - iterator);
+        }
+
+        /// Slicing does not copy any element.
+        ElementsOf slice(size_t begin, size_t end) const
+        {
+            return ElementsOf(Span<T const>(iterator + begin, end - begin));
+        }
+
+    private:
+        T const *iterator;
+        T const *end;
+    };
+
+    template<class T>
+    auto elementsOf(Span<T> span)
+    {
+        using ValueType = std::remove_const_t<T>;
+        return Flow(ElementsOf<ValueType>(Span<ValueType const>(span.data(), span.size())));
+    }
+
+    template<class T>
+    auto elementsOf(T const *data, size_t size)
+    {
+        return Flow(ElementsOf<T>(Span<T const>(data, size)));
+    }
+
+    /// Borrows the elements of a contiguous container, such as `std::vector` or `std::array`.
+    template<class C>
+    auto elementsOf(C const &container)
+    {
+        return elementsOf(container.data(), container.size());
+    }
+
+    /// Temporary containers are rejected, because their elements would dangle before the sequence is iterated.
+    template<class C>
+    auto elementsOf(C const &&container) = delete;
+}
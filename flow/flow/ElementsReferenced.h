@@ -1,6 +1,9 @@
 #pragma once
 
+#include <flow/Advance.h>
 #include <flow/Flow.h>
+#include <flow/SizeHint.h>
+#include <flow/TryFold.h>
 
 namespace flow
 {
@@ -36,6 +39,55 @@ namespace flow
             }
         }
 
+        /// Skips elements without moving them out of the container,
+        /// in constant time if the container's iterators are random-access.
+        size_t advanceBy(size_t n)
+        {
+            if constexpr (details::isRandomAccessIterator<IteratorType>)
+            {
+                size_t skipped = std::min(n, static_cast<size_t>(end - iterator));
+                iterator += skipped;
+                return skipped;
+            }
+            else
+            {
+                size_t skipped = 0;
+                for (; skipped < n && iterator != end; ++skipped)
+                {
+                    ++iterator;
+                }
+                return skipped;
+            }
+        }
+
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            while (iterator != end)
+            {
+                ElementType element = *iterator;
+                ++iterator;
+                if (!function(accumulator, element))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// The hint is exact if the container's iterators are random-access.
+        SizeHint sizeHint() const
+        {
+            if constexpr (details::isRandomAccessIterator<IteratorType>)
+            {
+                return SizeHint::exactly(static_cast<size_t>(end - iterator));
+            }
+            else
+            {
+                return SizeHint::unknown();
+            }
+        }
+
     private:
         C &container;
         IteratorType iterator;
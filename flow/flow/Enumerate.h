@@ -0,0 +1,100 @@
+#pragma once
+
+#include <tuple>
+
+#include <flow/Advance.h>
+#include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/Slice.h>
+#include <flow/TryFold.h>
+
+namespace flow
+{
+    /// Identifies each element with a growing index, starting at zero.
+    /// Arity: 1 -> 1
+    template<class S>
+    class Enumerate
+    {
+    public:
+        using ElementType = std::tuple<size_t, typename S::ElementType>;
+
+        static constexpr bool isExactlySliceable = details::isExactlySliceable<S>;
+
+        explicit Enumerate(S &&sequence, size_t index = 0):
+            sequence(std::move(sequence)),
+            index(index)
+        {
+        }
+
+        Maybe<ElementType> next()
+        {
+            Maybe<typename S::ElementType> nextElement = sequence.next();
+            if (nextElement.hasValue())
+            {
+                return ElementType(index++, std::move(nextElement).value());
+            }
+            else
+            {
+                return None();
+            }
+        }
+
+        /// Skipped elements still consume their index.
+        size_t advanceBy(size_t n)
+        {
+            size_t skipped = flow::advanceBy(sequence, n);
+            index += skipped;
+            return skipped;
+        }
+
+        template<class A, class G>
+        bool tryFold(A &accumulator, G &&consumer)
+        {
+            using BaseElementType = typename S::ElementType;
+            return flow::tryFold(sequence, accumulator, [&] (A &acc, BaseElementType &&element)
+            {
+                return consumer(acc, ElementType(index++, std::forward<BaseElementType>(element)));
+            });
+        }
+
+        SizeHint sizeHint() const
+        {
+            return flow::sizeHint(sequence);
+        }
+
+        /// Each slice continues counting at the index of its first element.
+        /// Only available if the base sequence yields exactly one element per position.
+        template<class T = S, class = std::enable_if_t<details::isExactlySliceable<T>>>
+        Enumerate slice(size_t begin, size_t end) const
+        {
+            return Enumerate(sequence.slice(begin, end), index + begin);
+        }
+
+        /// Splits the base sequence, the second half continuing counting where the first half ends.
+        template<class T = S, class = std::enable_if_t<details::isExactlySliceable<T>>>
+        Maybe<std::pair<Enumerate, Enumerate>> split() const
+        {
+            Maybe<std::pair<S, S>> halves = flow::split(sequence);
+            if (!halves.hasValue())
+            {
+                return None();
+            }
+            size_t middle = index + slicePositions(halves.value().first);
+            return std::pair<Enumerate, Enumerate>(
+                Enumerate(std::move(halves.value().first), index),
+                Enumerate(std::move(halves.value().second), middle));
+        }
+
+    private:
+        S sequence;
+        size_t index;
+    };
+
+    inline auto enumerate()
+    {
+        return [] (auto &&sequence)
+        {
+            return Enumerate(std::move(sequence));
+        };
+    }
+}
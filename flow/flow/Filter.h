@@ -1,7 +1,12 @@
 #pragma once
 
 //#include <flow/Map.h>
+#include <flow/Batch.h>
 #include <flow/Maybe.h>
+#include <flow/Simd.h>
+#include <flow/SizeHint.h>
+#include <flow/Slice.h>
+#include <flow/TryFold.h>
 #include <flow/details.h>
 
 namespace flow
@@ -32,13 +37,89 @@ namespace flow
                 
                 // If the predicate validates the element, return it.
                 // Otherwise, continue on the next element.
-                if (predicate(reinterpret_cast<ElementType const &>(nextElement.value())))
+                if (predicate(static_cast<ElementType const &>(nextElement.value())))
                 {
                     return nextElement;
                 }
             }
         }
+
+        /// Pulls a block from the base sequence directly into the given batch
+        /// and compacts the accepted elements towards its front.
+        /// Vectorizable predicates, such as `lessThan(x)`, are evaluated on whole vectors of arithmetic elements,
+        /// which avoids mispredicted branches on unpredictable predicates.
+        size_t nextBatch(Span<ElementType> batch)
+        {
+            for (;;)
+            {
+                size_t pulled = flow::nextBatch(sequence, batch);
+                if (pulled == 0)
+                {
+                    // Sequence is exhausted.
+                    return 0;
+                }
+
+                size_t accepted = 0;
+                if constexpr (details::simd::isVectorizablePredicate<F, ElementType>)
+                {
+                    accepted = details::simd::compact(batch.data(), pulled, predicate);
+                }
+                else
+                {
+                    for (size_t i = 0; i < pulled; ++i)
+                    {
+                        if (predicate(static_cast<ElementType const &>(batch[i])))
+                        {
+                            if (accepted != i)
+                            {
+                                batch[accepted] = std::move(batch[i]);
+                            }
+                            ++accepted;
+                        }
+                    }
+                }
+
+                // A block without any accepted element must not be reported as exhaustion.
+                if (accepted > 0)
+                {
+                    return accepted;
+                }
+            }
+        }
+
+        template<class A, class G>
+        bool tryFold(A &accumulator, G &&consumer)
+        {
+            return flow::tryFold(sequence, accumulator, [&] (A &acc, ElementType &&element)
+            {
+                if (predicate(static_cast<ElementType const &>(element)))
+                {
+                    return consumer(acc, std::forward<ElementType>(element));
+                }
+                return true;
+            });
+        }
+
+        /// Any element might be rejected, so only the upper bound is kept.
+        SizeHint sizeHint() const
+        {
+            return SizeHint{0, flow::sizeHint(sequence).upper};
+        }
         
+        /// Slices the base sequence, each slice getting its own copy of the predicate.
+        template<class T = S, class = std::enable_if_t<details::isSliceable<T>>>
+        Filter slice(size_t begin, size_t end) const
+        {
+            return Filter(sequence.slice(begin, end), predicate);
+        }
+
+        /// Splits the base sequence, each half getting its own copy of the predicate.
+        template<class T = S, class = std::enable_if_t<details::isSliceable<T>>>
+        Maybe<std::pair<Filter, Filter>> split() const
+        {
+            return details::splitWrapped(sequence, [this] (S &&half) { return Filter(std::move(half), predicate); });
+        }
+
     private:
         S sequence;
         F predicate;
@@ -1,12 +1,48 @@
 #pragma once
 
+#include <functional>
+#include <type_traits>
+
+#include <flow/Advance.h>
+#include <flow/Batch.h>
 #include <flow/Fuse.h>
 #include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/TryFold.h>
 #include <flow/details.h>
 
 namespace flow
 {
+    namespace details
+    {
+        /// Whether the sequence is known to yield no elements, so that it can be skipped without being iterated.
+        template<class S>
+        bool isKnownEmpty(S const &sequence)
+        {
+            SizeHint hint = flow::sizeHint(sequence);
+            return hint.upper.hasValue() && hint.upper.value() == 0;
+        }
+
+        /// At least the remainder of the current sub sequence is yielded.
+        /// The total is only bounded if there is no further sub sequence.
+        template<class S, class T>
+        SizeHint flattenedSizeHint(S const &sequence, Maybe<T> const &currentSubSequence)
+        {
+            SizeHint currentHint = currentSubSequence.hasValue()
+                ? flow::sizeHint(currentSubSequence.value())
+                : SizeHint::exactly(0);
+            if (isKnownEmpty(sequence))
+            {
+                return currentHint;
+            }
+            return SizeHint{currentHint.lower, None()};
+        }
+    }
+
     /// Reduces the sequence depth by one.
+    /// Sub sequences known to be empty are skipped without being stored.
+    /// Batches are filled block by block from each sub sequence,
+    /// which copies straight out of the storage of contiguous sub sequences.
 	/// Arity: 1 -> 1
     template<class S>
     class Flatten
@@ -37,7 +73,7 @@ namespace flow
                 }
                 
                 // Current sub sequence is exhausted, go to next.
-                if (!(currentSubSequence = sequence.next()).hasValue())
+                if (!nextSubSequence())
                 {
                     // The base sequence is exhausted.
                     // There are ultimately no elements left.
@@ -46,12 +82,246 @@ namespace flow
             }
         }
 
+        /// Fills the batch from as many sub sequences as needed.
+        template<class E = ElementType, class = std::enable_if_t<details::isBatchable<E>>>
+        size_t nextBatch(Span<E> batch)
+        {
+            size_t count = 0;
+            while (count < batch.size())
+            {
+                if (currentSubSequence.hasValue())
+                {
+                    size_t pulled = flow::nextBatch(currentSubSequence.value(), batch.subspan(count, batch.size() - count));
+                    if (pulled != 0)
+                    {
+                        count += pulled;
+                        continue;
+                    }
+                }
+
+                if (!nextSubSequence())
+                {
+                    break;
+                }
+            }
+            return count;
+        }
+
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            for (;;)
+            {
+                if (currentSubSequence.hasValue() && !flow::tryFold(currentSubSequence.value(), accumulator, function))
+                {
+                    return false;
+                }
+
+                // Current sub sequence is exhausted, go to next.
+                if (!nextSubSequence())
+                {
+                    return true;
+                }
+            }
+        }
+
+        SizeHint sizeHint() const
+        {
+            return details::flattenedSizeHint(sequence, currentSubSequence);
+        }
+
     private:
+        /// Moves the next non-empty sub sequence into the storage of the current one.
+        /// Returns false if the base sequence is exhausted.
+        bool nextSubSequence()
+        {
+            for (;;)
+            {
+                Maybe<SubSequenceType> subSequence = sequence.next();
+                if (!subSequence.hasValue())
+                {
+                    currentSubSequence = None();
+                    return false;
+                }
+                if (!details::isKnownEmpty(subSequence.value()))
+                {
+                    currentSubSequence = std::move(subSequence);
+                    return true;
+                }
+            }
+        }
+
         S sequence;
         Maybe<SubSequenceType> currentSubSequence;
     };
 
-    auto flatten()
+    /// Maps each element to a sub sequence and yields the elements of all sub sequences.
+    /// Unlike `map` followed by `flatten`, the current element is kept alive while its sub sequence is iterated,
+    /// so that the function can return a sequence borrowing from the element,
+    /// e.g. `flatMap([] (std::vector<int> const &v) { return elementsOf(v); })`, instead of copying it.
+    /// Together with a base sequence yielding references, such as `elementsReferenced(rows)`, no inner container is copied.
+    /// Each element is moved into the storage of the previous one.
+    /// Copying or moving this sequence calls the function again on the current element and skips to the
+    /// current position, so the function must return equal sub sequences for equal elements.
+    /// Arity: 1 -> 1
+    template<class S, class F>
+    class FlatMap
+    {
+    public:
+        using InputType = typename S::ElementType;
+        using SubSequenceType = std::remove_cv_t<std::remove_reference_t<
+            std::invoke_result_t<F &, std::remove_reference_t<InputType> &>>>;
+        using ElementType = typename SubSequenceType::ElementType;
+
+        FlatMap(S &&sequence, F function):
+            sequence(std::move(sequence)),
+            function(std::move(function))
+        {
+        }
+
+        FlatMap(FlatMap const &other):
+            sequence(other.sequence),
+            function(other.function),
+            current(other.current),
+            yielded(other.yielded)
+        {
+            restoreSubSequence();
+        }
+
+        FlatMap(FlatMap &&other):
+            sequence(std::move(other.sequence)),
+            function(std::move(other.function)),
+            current(std::move(other.current)),
+            yielded(other.yielded)
+        {
+            restoreSubSequence();
+        }
+
+        FlatMap &operator=(FlatMap const &) = delete;
+        FlatMap &operator=(FlatMap &&) = delete;
+
+        Maybe<ElementType> next()
+        {
+            for (;;)
+            {
+                if (subSequence.hasValue())
+                {
+                    Maybe<ElementType> nextElement = subSequence.value().next();
+                    if (nextElement.hasValue())
+                    {
+                        ++yielded;
+                        return nextElement;
+                    }
+                }
+
+                if (!nextSubSequence())
+                {
+                    return None();
+                }
+            }
+        }
+
+        /// Fills the batch from as many sub sequences as needed.
+        template<class E = ElementType, class = std::enable_if_t<details::isBatchable<E>>>
+        size_t nextBatch(Span<E> batch)
+        {
+            size_t count = 0;
+            while (count < batch.size())
+            {
+                if (subSequence.hasValue())
+                {
+                    size_t pulled = flow::nextBatch(subSequence.value(), batch.subspan(count, batch.size() - count));
+                    if (pulled != 0)
+                    {
+                        yielded += pulled;
+                        count += pulled;
+                        continue;
+                    }
+                }
+
+                if (!nextSubSequence())
+                {
+                    break;
+                }
+            }
+            return count;
+        }
+
+        template<class A, class G>
+        bool tryFold(A &accumulator, G &&consumer)
+        {
+            for (;;)
+            {
+                if (subSequence.hasValue())
+                {
+                    bool completed = flow::tryFold(subSequence.value(), accumulator, [&] (A &acc, ElementType &&element)
+                    {
+                        ++yielded;
+                        return consumer(acc, std::forward<ElementType>(element));
+                    });
+                    if (!completed)
+                    {
+                        return false;
+                    }
+                }
+
+                if (!nextSubSequence())
+                {
+                    return true;
+                }
+            }
+        }
+
+        SizeHint sizeHint() const
+        {
+            return details::flattenedSizeHint(sequence, subSequence);
+        }
+
+    private:
+        /// Moves the next element into the storage of the current one and maps it to its sub sequence,
+        /// skipping elements mapped to sub sequences known to be empty.
+        /// Returns false if the base sequence is exhausted.
+        bool nextSubSequence()
+        {
+            // The sub sequence may borrow from the current element, so it is dropped first.
+            // Sub sequences are reinitialized instead of assigned, since borrowing sequences are often not assignable.
+            details::reinitialize(subSequence, Maybe<SubSequenceType>(None()));
+            yielded = 0;
+            for (;;)
+            {
+                current = sequence.next();
+                if (!current.hasValue())
+                {
+                    return false;
+                }
+                details::reinitialize(subSequence, Maybe<SubSequenceType>(std::invoke(function, current.value())));
+                if (!details::isKnownEmpty(subSequence.value()))
+                {
+                    return true;
+                }
+                details::reinitialize(subSequence, Maybe<SubSequenceType>(None()));
+            }
+        }
+
+        void restoreSubSequence()
+        {
+            if (current.hasValue())
+            {
+                details::reinitialize(subSequence, Maybe<SubSequenceType>(std::invoke(function, current.value())));
+                flow::advanceBy(subSequence.value(), yielded);
+            }
+        }
+
+        S sequence;
+        F function;
+        Maybe<InputType> current = None();
+        Maybe<SubSequenceType> subSequence = None();
+
+        /// The number of elements yielded from the current sub sequence, needed to restore it in copies.
+        size_t yielded = 0;
+    };
+
+    inline auto flatten()
     {
         return [] (auto &&sequence)
         {
@@ -59,4 +329,14 @@ namespace flow
         };
     }
 
+    /// Maps each element to a sequence through the given function and flattens the result.
+    template<class F>
+    auto flatMap(F function)
+    {
+        return [function = std::move(function)] (auto &&sequence) mutable
+        {
+            using S = std::remove_reference_t<decltype(sequence)>;
+            return FlatMap<S, F>(std::move(sequence), std::move(function));
+        };
+    }
 }
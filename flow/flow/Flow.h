@@ -1,8 +1,14 @@
 #pragma once
 
+#include <flow/Advance.h>
+#include <flow/Batch.h>
 #include <flow/details.h>
 #include <flow/Iterator.h>
 #include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/Slice.h>
+#include <flow/SliceView.h>
+#include <flow/TryFold.h>
 
 namespace flow
 {
@@ -10,13 +16,15 @@ namespace flow
     
     /// A flow, dependend on a basing flow and on a function, which not only may map the values
     /// coming from the base flow to new values, but may also decide on how to iterate over the base flow.
+    /// Composing flows moves the nested stages into the new flow when the composed flow is an rvalue,
+    /// so that building a pipeline out of temporaries never copies captured state and works with move-only closures.
     template<class B, class F>
     struct Flow2
     {
         B baseFlow;
         F function;
                 
-        Flow2(B const &baseFlow, F const &function): baseFlow(baseFlow), function(function)
+        Flow2(B baseFlow, F function): baseFlow(std::move(baseFlow)), function(std::move(function))
         {
         }
 
@@ -32,11 +40,18 @@ namespace flow
             }
         }
         
-        /// Appends the given functor to this flow.
+        /// Appends the given functor to this flow, which is moved into the new flow.
         template<class E>
-        auto operator|(Functor<E> const &flowSegment)
+        auto operator|(Functor<E> flowSegment) &&
         {
-            return Flow2<Flow2<B, F>, E>(*this, flowSegment.function);
+            return Flow2<Flow2<B, F>, E>(std::move(*this), std::move(flowSegment.function));
+        }
+        
+        /// Appends the given functor to a copy of this flow.
+        template<class E>
+        auto operator|(Functor<E> flowSegment) const &
+        {
+            return Flow2<Flow2<B, F>, E>(*this, std::move(flowSegment.function));
         }
     };
 
@@ -48,16 +63,22 @@ namespace flow
     {
         F function;
 
-        Functor(F const &function): function(function)
+        Functor(F function): function(std::move(function))
         {
         }
 
         /// Appends another functor to this one.
         /// This turns the given functor into a flow, which receives its elements from this functor.
         template<class E>
-        auto operator|(Functor<E> const &functor)
+        auto operator|(Functor<E> functor) &&
         {
-            return Flow2(*this, functor.function);
+            return Flow2(std::move(*this), std::move(functor.function));
+        }
+        
+        template<class E>
+        auto operator|(Functor<E> functor) const &
+        {
+            return Flow2(*this, std::move(functor.function));
         }
     };
     
@@ -66,7 +87,7 @@ namespace flow
     {
         F function;
                 
-        Generator(F const &function): function(function) {}
+        Generator(F function): function(std::move(function)) {}
         
         auto next()
         {
@@ -80,12 +101,19 @@ namespace flow
             }
         }
         
-        /// Appends a functor to this generator.
+        /// Appends a functor to this generator, which is moved into the new flow.
         /// This will turn the given functor into a flow.
         template<class E>
-        auto operator|(Functor<E> functor)
+        auto operator|(Functor<E> functor) &&
+        {
+            return Flow2(std::move(*this), std::move(functor.function));
+        }
+        
+        /// Appends a functor to a copy of this generator.
+        template<class E>
+        auto operator|(Functor<E> functor) const &
         {
-            return Flow2(*this, functor.function);
+            return Flow2(*this, std::move(functor.function));
         }
     };
     
@@ -98,10 +126,82 @@ namespace flow
     public:
         using ElementType = typename S::ElementType;
 
+        static constexpr bool isContiguous = details::isContiguous<S>;
+        static constexpr bool isExactlySliceable = details::isExactlySliceable<S>;
+
         Maybe<ElementType> next()
         {
             return sequence.next();
         }
+
+        /// Only available if the sequence implements the batch protocol itself.
+        template<class T = S, class = std::enable_if_t<details::hasNextBatch<T>>>
+        size_t nextBatch(Span<ElementType> batch)
+        {
+            return flow::nextBatch(sequence, batch);
+        }
+
+        size_t advanceBy(size_t n)
+        {
+            return flow::advanceBy(sequence, n);
+        }
+
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            return flow::tryFold(sequence, accumulator, std::forward<F>(function));
+        }
+
+        SizeHint sizeHint() const
+        {
+            return flow::sizeHint(sequence);
+        }
+
+        /// Only available if the sequence is contiguous.
+        template<class T = S, class = std::enable_if_t<details::isContiguous<T>>>
+        auto data() const
+        {
+            return sequence.data();
+        }
+
+        /// Only available if the sequence is contiguous.
+        template<class T = S, class = std::enable_if_t<details::isContiguous<T>>>
+        size_t size() const
+        {
+            return sequence.size();
+        }
+
+        /// Views the remaining elements without consuming them.
+        /// The pointers of the span are random-access iterators, so that standard algorithms take their fast paths.
+        /// Only available if the sequence is contiguous.
+        template<class T = S, class = std::enable_if_t<details::isContiguous<T>>>
+        auto span() const
+        {
+            return Span(sequence.data(), sequence.size());
+        }
+
+        /// Views the remaining elements without consuming them, through random-access iterators computing each element,
+        /// e.g. to binary search a `range` by `std::lower_bound`.
+        /// Only available if the sequence yields exactly one element per position, see `SliceView`.
+        template<class T = S, class = std::enable_if_t<details::isExactlySliceable<T>>>
+        SliceView<S> view() const
+        {
+            return SliceView<S>(sequence);
+        }
+
+        /// Only available if the sequence is sliceable.
+        template<class T = S, class = std::enable_if_t<details::isSliceable<T>>>
+        Flow slice(size_t begin, size_t end) const
+        {
+            return Flow(sequence.slice(begin, end));
+        }
+
+        /// Only available if the sequence chooses its own split point.
+        template<class T = S, class = std::enable_if_t<details::hasSplit<T>>>
+        Maybe<std::pair<Flow, Flow>> split() const
+        {
+            return details::splitWrapped(sequence, [] (S &&half) { return Flow(std::move(half)); });
+        }
         
         explicit Flow(S const &sequence):
             sequence(sequence)
@@ -127,12 +227,29 @@ namespace flow
             return Flow<details::FunctionReturnType<C, S>>(sequenceConstructor(S(sequence)));
         }
         
-        Iterator<S> begin()
+        /// The returned iterator borrows the sequence, so this flow must outlive it.
+        /// This is the case in range-based for loops, even if iterating over a temporary flow.
+        /// Like any input iterator, it pulls its first element on construction, so calling `begin()` consumes
+        /// the first element of this flow. Use `span()` or `view()` to iterate elements without consuming them.
+        Iterator<S &> begin() &
+        {
+            return Iterator<S &>(sequence);
+        }
+        
+        /// The returned iterator takes over the sequence.
+        Iterator<S> begin() &&
+        {
+            return Iterator<S>(std::move(sequence));
+        }
+        
+        /// Returns an end iterator of the same type as `begin()`, as required by algorithms taking an iterator pair.
+        Iterator<S &> end() &
         {
-            return Iterator<S>(sequence);
+            return Iterator<S &>();
         }
         
-        EndIterator end()
+        /// Returns the sentinel for iterators taking over the sequence.
+        EndIterator end() &&
         {
             return EndIterator{};
         }
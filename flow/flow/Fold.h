@@ -1,38 +1,112 @@
 #pragma once
 
+#include <type_traits>
+
 #include <flow/details.h>
+#include <flow/Maybe.h>
+#include <flow/TryFold.h>
 
 namespace flow
 {
+    namespace details
+    {
+        template<class F, class T, class E, bool = std::is_invocable_v<F &, T &, E>>
+        struct IsInPlaceAccumulation: std::false_type
+        {
+        };
+
+        template<class F, class T, class E>
+        struct IsInPlaceAccumulation<F, T, E, true>: std::is_void<std::invoke_result_t<F &, T &, E>>
+        {
+        };
+
+        /// Whether the function modifies an accumulator passed by mutable reference instead of returning a new one,
+        /// which is the case if it does not return anything.
+        template<class F, class T, class E>
+        static constexpr bool isInPlaceAccumulation = IsInPlaceAccumulation<F, T, E>::value;
+
+        template<class S, class T, class F>
+        void accumulate(S &sequence, T &accumulator, F &function)
+        {
+            using ElementType = typename S::ElementType;
+
+            flow::tryFold(sequence, accumulator, [&] (T &acc, ElementType &&element)
+            {
+                if constexpr (isInPlaceAccumulation<F, T, ElementType>)
+                {
+                    function(acc, std::forward<ElementType>(element));
+                }
+                else if constexpr (std::is_invocable_v<F &, T &&, ElementType>)
+                {
+                    details::reinitialize(acc, function(std::move(acc), std::forward<ElementType>(element)));
+                }
+                else
+                {
+                    // The accumulator is destroyed before the result is moved into it.
+                    static_assert(!std::is_reference_v<std::invoke_result_t<F &, T &, ElementType>>,
+                        "Functions taking the accumulator by mutable reference either return nothing or a new accumulator.");
+                    details::reinitialize(acc, function(acc, std::forward<ElementType>(element)));
+                }
+                return true;
+            });
+        }
+    }
+
+    /// Accumulates the elements into the given accumulator by calling `function(accumulator, element)`,
+    /// which modifies the accumulator in place, e.g. appending to a string or counting into a map.
+    /// Unlike `fold`, the accumulator is neither copied nor reconstructed per element.
+    /// Returns the accumulator.
+    template<class S, class T, class F>
+    T &reduceInto(S sequence, T &accumulator, F function)
+    {
+        using ElementType = typename S::ElementType;
+
+        flow::tryFold(sequence, accumulator, [&] (T &acc, ElementType &&element)
+        {
+            function(acc, std::forward<ElementType>(element));
+            return true;
+        });
+
+        return accumulator;
+    }
+
+    /// Folds the elements starting at a copy of `initial`.
+    /// The function either returns the next accumulator, `function(accumulator, element) -> T`,
+    /// or modifies the accumulator in place like `reduceInto`, `function(T &accumulator, element) -> void`.
     template<class S, class F, class T>
     T fold(S sequence, T const &initial, F function) {
         T acc = initial;
-        
-        for (Maybe<typename S::ElementType> maybe = sequence.next(); maybe.hasValue(); maybe = sequence.next())
-        {
-            details::reinitialize(acc, function(std::move(acc), maybe.value()));
-        }
-        
+        details::accumulate(sequence, acc, function);
         return acc;
     }
 
     template<class S, class F, class T = typename S::ElementType>
     Maybe<T>
     fold(S sequence, F function) {
-        Maybe<typename S::ElementType> maybe = sequence.next();
+        using ElementType = typename S::ElementType;
+        
+        Maybe<ElementType> maybe = sequence.next();
         
         if (!maybe.hasValue())
         {
             return None();
         }
         
-        T acc = maybe.value();
-
-        for (Maybe<typename S::ElementType> maybe = sequence.next(); maybe.hasValue(); maybe = sequence.next())
-        {
-            details::reinitialize(acc, function(std::move(acc), maybe.value()));
-        }
-        
+        T acc = std::move(maybe).value();
+        details::accumulate(sequence, acc, function);
         return acc;
     }
+    
+    /// Calls the function on each element of the sequence.
+    template<class S, class F>
+    void forEach(S sequence, F function) {
+        using ElementType = typename S::ElementType;
+        
+        None nothing;
+        flow::tryFold(sequence, nothing, [&] (None &, ElementType &&element)
+        {
+            function(std::forward<ElementType>(element));
+            return true;
+        });
+    }
 }
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <flow/Advance.h>
 #include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/TryFold.h>
 
 namespace flow
 {
@@ -18,7 +21,7 @@ namespace flow
             exhausted(false)
         {}
         
-        Maybe<ElementType> probe()
+        Maybe<ElementType> next()
         {
             if (exhausted)
             {
@@ -40,6 +43,42 @@ namespace flow
             }
         }
 
+        size_t advanceBy(size_t n)
+        {
+            if (exhausted)
+            {
+                return 0;
+            }
+
+            size_t skipped = flow::advanceBy(sequence, n);
+            if (skipped < n)
+            {
+                exhausted = true;
+            }
+            return skipped;
+        }
+
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            if (exhausted)
+            {
+                return true;
+            }
+
+            if (flow::tryFold(sequence, accumulator, std::forward<F>(function)))
+            {
+                exhausted = true;
+                return true;
+            }
+            return false;
+        }
+
+        SizeHint sizeHint() const
+        {
+            return exhausted ? SizeHint::exactly(0) : flow::sizeHint(sequence);
+        }
+
     private:
         S sequence;
         bool exhausted;
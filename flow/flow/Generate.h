@@ -1,7 +1,9 @@
 #pragma once
 
 #include <flow/details.h>
+#include <flow/Flow.h>
 #include <flow/Maybe.h>
+#include <flow/SizeHint.h>
 
 namespace flow
 {
@@ -30,11 +32,44 @@ namespace flow
         return Flow(Generate(generator));
     }
     
-    auto successors(size_t i)
+    /// Yields consecutive numbers of type `T`, starting at the given one.
+    /// This sequence is infinite.
+    template<class T>
+    class Successors
     {
-        return generate([=] () mutable -> Maybe<int>
+    public:
+        using ElementType = T;
+
+        explicit Successors(T i):
+            i(i)
+        {
+        }
+
+        Maybe<ElementType> next()
         {
             return i++;
-        });
+        }
+
+        size_t advanceBy(size_t n)
+        {
+            i += static_cast<T>(n);
+            return n;
+        }
+
+        SizeHint sizeHint() const
+        {
+            return SizeHint::infinite();
+        }
+
+    private:
+        T i;
+    };
+    
+    /// The element type is the type of the first number, so that `successors(1)` yields `int`s
+    /// and `successors(size_t(0))` yields `size_t`s. Use `range` for a bounded sequence of numbers.
+    template<class T>
+    auto successors(T i)
+    {
+        return Flow(Successors<T>(i));
     }
 }
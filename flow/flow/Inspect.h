@@ -1,6 +1,10 @@
 #pragma once
 
+#include <flow/Batch.h>
 #include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/Slice.h>
+#include <flow/TryFold.h>
 
 namespace flow
 {
@@ -12,6 +16,8 @@ namespace flow
     public:
         using ElementType = typename S::ElementType;
 
+        static constexpr bool isExactlySliceable = details::isExactlySliceable<S>;
+
         Inspect(S &&sequence, F function):
             sequence(std::move(sequence)),
             function(function)
@@ -31,6 +37,45 @@ namespace flow
             return nextElement;
         }
 
+        size_t nextBatch(Span<ElementType> batch)
+        {
+            size_t count = flow::nextBatch(sequence, batch);
+            for (size_t i = 0; i < count; ++i)
+            {
+                function(static_cast<ElementType const &>(batch[i]));
+            }
+            return count;
+        }
+
+        template<class A, class G>
+        bool tryFold(A &accumulator, G &&consumer)
+        {
+            return flow::tryFold(sequence, accumulator, [&] (A &acc, ElementType &&element)
+            {
+                function(static_cast<ElementType const &>(element));
+                return consumer(acc, std::forward<ElementType>(element));
+            });
+        }
+
+        SizeHint sizeHint() const
+        {
+            return flow::sizeHint(sequence);
+        }
+
+        /// Slices the base sequence, each slice getting its own copy of the function.
+        template<class T = S, class = std::enable_if_t<details::isSliceable<T>>>
+        Inspect slice(size_t begin, size_t end) const
+        {
+            return Inspect(sequence.slice(begin, end), function);
+        }
+
+        /// Splits the base sequence, each half getting its own copy of the function.
+        template<class T = S, class = std::enable_if_t<details::isSliceable<T>>>
+        Maybe<std::pair<Inspect, Inspect>> split() const
+        {
+            return details::splitWrapped(sequence, [this] (S &&half) { return Inspect(std::move(half), function); });
+        }
+
     private:
         S sequence;
         F function;
@@ -1,27 +1,73 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
 #include <flow/Maybe.h>
 
 namespace flow
 {
+    /// The sentinel terminating iterators over a sequence.
+    /// It compares equal to iterators whose sequence is exhausted.
     class EndIterator
     {
     };
     
-    /// A forward iterator, yielding elements from a sequence.
+    /// An input iterator, yielding elements from a sequence.
     /// When incrementing this iterator, the next element is stored.
     /// It can be accessed by using the dereference operator.
+    /// If `S` is a reference, the sequence is borrowed, otherwise it is owned by the iterator.
+    /// Borrowing iterators can also be default constructed, giving an end iterator of the same type,
+    /// which is what algorithms taking an iterator pair, e.g. `std::vector(begin, end)`, require.
     template<class S>
     class Iterator
     {
+        using SequenceType = std::remove_reference_t<S>;
+        using ElementType = typename SequenceType::ElementType;
+        static constexpr bool isBorrowing = std::is_reference_v<S>;
+        
     public:
-        /// The type of elements yielded by this iterator is simply the type of elements yielded by the underlying sequence.
-        using value_type = typename S::ElementType;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::remove_cv_t<std::remove_reference_t<ElementType>>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::add_pointer_t<std::remove_reference_t<ElementType>>;
+        using reference = std::add_lvalue_reference_t<ElementType>;
         
-        /// Constructs an iterator yielding elements from the given sequence.
-        explicit Iterator(S const &sequence):
-            sequence(sequence),
-            element(this->sequence.next())
+        /// Holds the element an iterator was pointing to before being post-incremented.
+        class Proxy
+        {
+        public:
+            reference operator*()
+            {
+                return element.value();
+            }
+            
+        private:
+            friend class Iterator;
+            
+            explicit Proxy(Maybe<ElementType> &&element):
+                element(std::move(element))
+            {
+            }
+            
+            Maybe<ElementType> element;
+        };
+        
+        /// Constructs an end iterator.
+        /// Only available for borrowing iterators.
+        template<class T = S, class = std::enable_if_t<std::is_reference_v<T>>>
+        Iterator():
+            sequence(nullptr),
+            element(None())
+        {
+        }
+        
+        /// Constructs an iterator yielding elements from the given sequence,
+        /// which is either borrowed or moved into the iterator, but never copied.
+        explicit Iterator(S &&sequence):
+            sequence(store(std::forward<S>(sequence))),
+            element(get().next())
         {
         }
         
@@ -30,36 +76,111 @@ namespace flow
         /// which can be queried by using the comparision function.
         Iterator &operator++()
         {
-            element = sequence.next();
+            element = get().next();
             return *this;
         }
         
+        /// Yields the next element from the sequence, returning a proxy to the previous one, so that `*i++` works.
+        Proxy operator++(int)
+        {
+            Proxy previous(std::move(element));
+            ++*this;
+            return previous;
+        }
+        
         /// Returns a mutable reference to the hold element.
         /// This must not be called if the element is `None`.
-        value_type &operator*()
+        reference operator*()
         {
             return element.value();
         }
         
         /// Returns a immutable reference to the hold element.
         /// This must not be called if the element is `None`.
-        value_type const &operator*() const
+        std::add_lvalue_reference_t<std::add_const_t<ElementType>> operator*() const
         {
             return element.value();
         }
         
+        pointer operator->()
+        {
+            return &element.value();
+        }
+        
+        /// Like any input iterators, two iterators are only equal if both are exhausted,
+        /// or if both borrow the same sequence and are not exhausted.
+        friend bool operator==(Iterator const &a, Iterator const &b)
+        {
+            if (a.element.hasValue() != b.element.hasValue())
+            {
+                return false;
+            }
+            if constexpr (isBorrowing)
+            {
+                return !a.element.hasValue() || a.sequence == b.sequence;
+            }
+            else
+            {
+                return !a.element.hasValue() || &a == &b;
+            }
+        }
+        
+        friend bool operator!=(Iterator const &a, Iterator const &b)
+        {
+            return !(a == b);
+        }
+        
         /// Compares against the end iterator sentinel.
         /// The result of the comparision does not depend on the actual given end-iterator but only whether the
-        /// element owned by this iterator is not `None`.
-        /// The interface is only implemented to make the range-based for-each loop construct working and to comply
-        /// with C++'s convention of iterating over iterators.
-        bool operator!=(EndIterator const&)
+        /// element owned by this iterator is `None`.
+        friend bool operator==(Iterator const &iterator, EndIterator)
         {
-            return element.hasValue();
+            return !iterator.element.hasValue();
+        }
+        
+        friend bool operator==(EndIterator, Iterator const &iterator)
+        {
+            return !iterator.element.hasValue();
+        }
+        
+        friend bool operator!=(Iterator const &iterator, EndIterator)
+        {
+            return iterator.element.hasValue();
+        }
+        
+        friend bool operator!=(EndIterator, Iterator const &iterator)
+        {
+            return iterator.element.hasValue();
         }
         
     private:
-        S sequence;
-        Maybe<value_type> element;
+        using Storage = std::conditional_t<isBorrowing, SequenceType *, S>;
+        
+        static Storage store(S &&sequence)
+        {
+            if constexpr (isBorrowing)
+            {
+                return &sequence;
+            }
+            else
+            {
+                return std::move(sequence);
+            }
+        }
+        
+        SequenceType &get()
+        {
+            if constexpr (isBorrowing)
+            {
+                return *sequence;
+            }
+            else
+            {
+                return sequence;
+            }
+        }
+        
+        Storage sequence;
+        Maybe<ElementType> element;
     };
 }
@@ -1,22 +1,45 @@
 #pragma once
 
+#include <functional>
+
+#include <flow/Advance.h>
+#include <flow/Batch.h>
 #include <flow/details.h>
+#include <flow/Enumerate.h>
 #include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/Slice.h>
+#include <flow/TryFold.h>
 #include <flow/Flow.h>
 
 namespace flow
 {
-    /// Maps each sequence element through a function.
+    namespace details
+    {
+        /// The element type of mapping elements of the given type through a function.
+        /// Lvalue references are yielded as they are if the elements are lvalue references themselves,
+        /// e.g. when projecting referenced elements onto one of their members.
+        /// Otherwise, references may refer into owned elements destroyed after mapping, so they are materialized instead,
+        /// e.g. when projecting owned elements onto one of their members, which moves the member out.
+        template<class F, class T, class R = std::invoke_result_t<F &, T>>
+        using MappedType = std::conditional_t<
+            !std::is_reference_v<R> || (std::is_lvalue_reference_v<R> && std::is_lvalue_reference_v<T>),
+            R,
+            std::remove_cv_t<std::remove_reference_t<R>>>;
+    }
+
+    /// Maps each sequence element through a function, which may also be a pointer to a member,
+    /// e.g. `map(&Person::name)`.
+    /// The function may return references, which are only yielded as references over referenced elements.
     /// Arity: 1 -> 1
     template<class S, class F>
     class Map
     {
     public:
         using FunctionInputType = typename S::ElementType;
-        using ElementType = details::FunctionReturnType<F, FunctionInputType>;
+        using ElementType = details::MappedType<F, FunctionInputType>;
 
-        static_assert(!std::is_lvalue_reference_v<ElementType>, "The mapped type must be owned.");
-        static_assert(!std::is_rvalue_reference_v<ElementType>, "The mapped type must be owned.");
+        static constexpr bool isExactlySliceable = details::isExactlySliceable<S>;
 
         Map(S &&sequence, F function):
             sequence(std::move(sequence)),
@@ -29,7 +52,7 @@ namespace flow
             Maybe<FunctionInputType> functionInput = sequence.next();
             if (functionInput.hasValue())
             {
-                return function(functionInput.value());
+                return ElementType(std::invoke(function, std::move(functionInput).value()));
             }
             else
             {
@@ -37,6 +60,56 @@ namespace flow
             }
         }
 
+        /// Pulls a block of inputs from the base sequence and maps them all at once.
+        template<
+            class I = FunctionInputType,
+            class E = ElementType,
+            class = std::enable_if_t<details::isBatchable<I> && details::isBatchable<E>>>
+        size_t nextBatch(Span<E> batch)
+        {
+            I inputs[details::batchSize];
+            size_t count = flow::nextBatch(sequence, Span<I>(inputs).subspan(0, std::min(batch.size(), details::batchSize)));
+            for (size_t i = 0; i < count; ++i)
+            {
+                batch[i] = std::invoke(function, std::move(inputs[i]));
+            }
+            return count;
+        }
+
+        /// Skipped elements are not passed through the function.
+        size_t advanceBy(size_t n)
+        {
+            return flow::advanceBy(sequence, n);
+        }
+
+        template<class A, class G>
+        bool tryFold(A &accumulator, G &&consumer)
+        {
+            return flow::tryFold(sequence, accumulator, [&] (A &acc, FunctionInputType &&functionInput)
+            {
+                return consumer(acc, ElementType(std::invoke(function, std::forward<FunctionInputType>(functionInput))));
+            });
+        }
+
+        SizeHint sizeHint() const
+        {
+            return flow::sizeHint(sequence);
+        }
+
+        /// Slices the base sequence, each slice getting its own copy of the function.
+        template<class T = S, class = std::enable_if_t<details::isSliceable<T>>>
+        Map slice(size_t begin, size_t end) const
+        {
+            return Map(sequence.slice(begin, end), function);
+        }
+
+        /// Splits the base sequence, each half getting its own copy of the function.
+        template<class T = S, class = std::enable_if_t<details::isSliceable<T>>>
+        Maybe<std::pair<Map, Map>> split() const
+        {
+            return details::splitWrapped(sequence, [this] (S &&half) { return Map(std::move(half), function); });
+        }
+
     private:
         S sequence;
         F function;
@@ -68,13 +141,13 @@ namespace flow
             }
         };
         
-        return Generator(f);
+        return Generator(std::move(f));
     }
     
     template<class F>
     auto map2(F function)
     {
-        return Functor([=] (auto &flow) {
+        return Functor([function = std::move(function)] (auto &flow) mutable {
             auto maybe = flow.next();
             return maybeIf(maybe.hasValue(), function(maybe.value()));
         });
@@ -113,14 +186,4 @@ namespace flow
             }
         });
     }
-    
-    /// Identifies each element with a growing index.
-    auto enumerate()
-    {
-        size_t k = 0;
-        return map([=] (auto const &element) mutable
-        {
-            return std::tuple(k++, element);
-        });
-    }
 }
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <flow/MaybeNiche.h>
+
 namespace flow
 {
     struct None
@@ -40,109 +46,293 @@ namespace flow
         {
             return true;
         }
+        
+        void setHasValue(bool)
+        {
+        }
     };
     
-    template<class T, bool WillAlwaysHaveValue = false>
-    class Maybe: private MaybeTag<WillAlwaysHaveValue>
+    namespace details
     {
-    public:
-        using ValueType = T;
-        using MaybeTag = MaybeTag<WillAlwaysHaveValue>;
-        
-        Maybe(None): MaybeTag(false)
+        /// Whether a maybe records the presence of its value in a separate flag,
+        /// as opposed to always having a value or encoding `None` into the value's niche.
+        template<class T, bool WillAlwaysHaveValue>
+        static constexpr bool hasMaybeFlag = !WillAlwaysHaveValue && !hasMaybeNiche<T>;
+
+        /// Queries and updates the presence of a maybe's value, either by its flag or by its niche.
+        template<class T, bool WillAlwaysHaveValue>
+        struct MaybePresence
         {
-        }
-        
-        Maybe(T const &value): MaybeTag(true), data(value)
+            template<class S>
+            static bool hasValue(S const &storage)
+            {
+                if constexpr (hasMaybeFlag<T, WillAlwaysHaveValue>)
+                {
+                    return storage.valid;
+                }
+                else if constexpr (WillAlwaysHaveValue)
+                {
+                    return true;
+                }
+                else
+                {
+                    return !MaybeNiche<T>::isNone(&storage.data);
+                }
+            }
+
+            /// Values are constructed before they are marked to be present,
+            /// and marked to be absent after they were destroyed.
+            template<class S>
+            static void setHasValue(S &storage, bool valid)
+            {
+                if constexpr (hasMaybeFlag<T, WillAlwaysHaveValue>)
+                {
+                    storage.valid = valid;
+                }
+                else if constexpr (!WillAlwaysHaveValue)
+                {
+                    if (!valid)
+                    {
+                        MaybeNiche<T>::setNone(&storage.data);
+                    }
+                }
+            }
+        };
+
+        /// Holds the value of a maybe.
+        /// The value is destroyed by a user-provided destructor only if its type is not trivially destructible,
+        /// so that maybes of such types are trivially destructible as well.
+        template<class T, bool WillAlwaysHaveValue, bool = std::is_trivially_destructible_v<T>>
+        class MaybeStorage: public MaybeTag<!hasMaybeFlag<T, WillAlwaysHaveValue>>
         {
-        }
+            using Presence = MaybePresence<T, WillAlwaysHaveValue>;
+            
+        public:
+            MaybeStorage(): MaybeTag<!hasMaybeFlag<T, WillAlwaysHaveValue>>(false)
+            {
+                Presence::setHasValue(*this, false);
+            }
+            
+            template<class... A>
+            explicit MaybeStorage(std::in_place_t, A &&...arguments):
+                MaybeTag<!hasMaybeFlag<T, WillAlwaysHaveValue>>(true),
+                data(std::forward<A>(arguments)...)
+            {
+            }
+            
+            bool hasValue() const
+            {
+                return Presence::hasValue(*this);
+            }
+            
+            void setHasValue(bool valid)
+            {
+                Presence::setHasValue(*this, valid);
+            }
+            
+            MaybeStorage(MaybeStorage const &) = default;
+            
+            MaybeStorage(MaybeStorage &&) = default;
+            
+            MaybeStorage &operator=(MaybeStorage const &) = default;
+            
+            MaybeStorage &operator=(MaybeStorage &&) = default;
+            
+            ~MaybeStorage()
+            {
+                if (this->hasValue())
+                {
+                    data.~T();
+                }
+            }
+            
+            union
+            {
+                T data;
+            };
+        };
         
-        Maybe(T &&value): MaybeTag(true), data(std::move(value))
+        template<class T, bool WillAlwaysHaveValue>
+        class MaybeStorage<T, WillAlwaysHaveValue, true>: public MaybeTag<!hasMaybeFlag<T, WillAlwaysHaveValue>>
         {
-        }
+            using Presence = MaybePresence<T, WillAlwaysHaveValue>;
+            
+        public:
+            MaybeStorage(): MaybeTag<!hasMaybeFlag<T, WillAlwaysHaveValue>>(false)
+            {
+                Presence::setHasValue(*this, false);
+            }
+            
+            template<class... A>
+            explicit MaybeStorage(std::in_place_t, A &&...arguments):
+                MaybeTag<!hasMaybeFlag<T, WillAlwaysHaveValue>>(true),
+                data(std::forward<A>(arguments)...)
+            {
+            }
+            
+            bool hasValue() const
+            {
+                return Presence::hasValue(*this);
+            }
+            
+            void setHasValue(bool valid)
+            {
+                Presence::setHasValue(*this, valid);
+            }
+            
+            union
+            {
+                T data;
+            };
+        };
         
-        Maybe(Maybe const &other): MaybeTag(other.hasValue())
+        /// Implements copying and moving maybes.
+        /// If the value type is trivially copyable, the maybe is trivially copyable as well,
+        /// which allows passing maybes in registers, e.g. when returning them from `next()`.
+        template<class T, bool WillAlwaysHaveValue, bool = std::is_trivially_copyable_v<T>>
+        class MaybeBase: public MaybeStorage<T, WillAlwaysHaveValue>
         {
-            if (hasValue())
+        public:
+            using MaybeStorage<T, WillAlwaysHaveValue>::MaybeStorage;
+            
+            MaybeBase() = default;
+            
+            MaybeBase(MaybeBase const &other): MaybeStorage<T, WillAlwaysHaveValue>()
             {
-                new (&data) T(other.data);
+                if (other.hasValue())
+                {
+                    construct(other.data);
+                }
             }
-        }
+            
+            MaybeBase(MaybeBase &&other): MaybeStorage<T, WillAlwaysHaveValue>()
+            {
+                if (other.hasValue())
+                {
+                    construct(std::move(other.data));
+                }
+            }
+            
+            MaybeBase &operator=(MaybeBase const &other)
+            {
+                if (this != &other)
+                {
+                    destroy();
+                    if (other.hasValue())
+                    {
+                        construct(other.data);
+                    }
+                }
+                return *this;
+            }
+            
+            MaybeBase &operator=(MaybeBase &&other)
+            {
+                if (this != &other)
+                {
+                    destroy();
+                    if (other.hasValue())
+                    {
+                        construct(std::move(other.data));
+                    }
+                }
+                return *this;
+            }
+            
+            /// Constructs the value in place, which must not be held yet.
+            template<class... A>
+            void construct(A &&...arguments)
+            {
+                new (&this->data) T(std::forward<A>(arguments)...);
+                this->setHasValue(true);
+            }
+            
+            void destroy()
+            {
+                if (this->hasValue())
+                {
+                    this->data.~T();
+                    this->setHasValue(false);
+                }
+            }
+        };
         
-        Maybe(Maybe &&other): MaybeTag(other.hasValue())
+        template<class T, bool WillAlwaysHaveValue>
+        class MaybeBase<T, WillAlwaysHaveValue, true>: public MaybeStorage<T, WillAlwaysHaveValue>
         {
-            if (hasValue())
+        public:
+            using MaybeStorage<T, WillAlwaysHaveValue>::MaybeStorage;
+            
+            template<class... A>
+            void construct(A &&...arguments)
+            {
+                new (&this->data) T(std::forward<A>(arguments)...);
+                this->setHasValue(true);
+            }
+            
+            void destroy()
             {
-                new (&data) T(std::move(other.data));
+                this->setHasValue(false);
             }
+        };
+    }
+    
+    template<class T, bool WillAlwaysHaveValue = false>
+    class Maybe: private details::MaybeBase<T, WillAlwaysHaveValue>
+    {
+        using Base = details::MaybeBase<T, WillAlwaysHaveValue>;
+        
+    public:
+        using ValueType = T;
+        
+        Maybe(None)
+        {
         }
         
-        ~Maybe()
+        Maybe(T const &value): Base(std::in_place, value)
         {
-            if (hasValue())
-            {
-                data.~T();
-            }
         }
         
-        Maybe &operator=(Maybe const &other)
+        Maybe(T &&value): Base(std::in_place, std::move(value))
         {
-            this->~Maybe();
-            MaybeTag::setHasValue(other.hasValue());
-            if (hasValue())
-            {
-                new (&data) T(other.data);
-            }
-            return *this;
         }
         
-        Maybe &operator=(T &&other)
+        Maybe &operator=(T &&value)
         {
-            this->~Maybe();
-            MaybeTag::setHasValue(other.hasValue());
-            if (hasValue())
-            {
-                new (&data) T(std::move(other.data));
-            }
-            
+            Base::destroy();
+            Base::construct(std::move(value));
             return *this;
         }
         
         bool hasValue() const
         {
-            return MaybeTag::hasValue();
+            return Base::hasValue();
         }
         
         T &value() &
         {
-            return data;
+            return this->data;
         }
         
         T const &value() const &
         {
-            return data;
+            return this->data;
         }
         
         T &&value() &&
         {
-            return std::move(data);
+            return std::move(this->data);
         }
         
         bool operator==(Maybe const &other) const
         {
-            return (!hasValue() && !other.hasValue()) || (hasValue() && other.hasValue() && data == other.data);
+            return (!hasValue() && !other.hasValue()) || (hasValue() && other.hasValue() && this->data == other.data);
         }
         
         bool operator!=(Maybe const &other) const
         {
             return !(*this == other);
         }
-        
-    private:
-        union
-        {
-            T data;
-        };
     };
     
     /// Implementation of the optional type where the held type is a reference.
@@ -163,15 +353,9 @@ namespace flow
         {
         }
         
-        Maybe(Maybe const &other): pointer(other.pointer)
-        {
-        }
+        Maybe(Maybe const &other) = default;
         
-        Maybe &operator=(Maybe const &other)
-        {
-            pointer = other.pointer;
-            return *this;
-        }
+        Maybe &operator=(Maybe const &other) = default;
         
         bool hasValue() const
         {
@@ -202,10 +386,50 @@ namespace flow
         T *pointer;
     };
     
-    /// Maybes over rvalue references are still illegal.
-    /// TODO: Does it make sense to implement them owning the value?
+    /// Implementation of the optional type where the held type is an rvalue reference.
+    /// Like maybes over lvalue references, the referred value is not owned, but it may be moved from
+    /// when accessing it, e.g. to hand out elements of a container which is consumed.
     template<class T>
-    class Maybe<T &&>;
+    class Maybe<T &&>
+    {
+    public:
+        using ValueType = T &&;
+        
+        Maybe(None): pointer(nullptr)
+        {
+        }
+        
+        Maybe(T &&reference): pointer(&reference)
+        {
+        }
+        
+        Maybe(Maybe const &other) = default;
+        
+        Maybe &operator=(Maybe const &other) = default;
+        
+        bool hasValue() const
+        {
+            return pointer != nullptr;
+        }
+        
+        T &&value() const
+        {
+            return std::move(*pointer);
+        }
+        
+        bool operator==(Maybe const &other) const
+        {
+            return (!pointer && !other.pointer) || (pointer && other.pointer && *pointer == *other.pointer);
+        }
+        
+        bool operator!=(Maybe const &other) const
+        {
+            return !(*this == other);
+        }
+        
+    private:
+        T *pointer;
+    };
     
     template<class T>
     Maybe<T, true> some(T &&value)
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+
+namespace flow
+{
+    /// Customization point for maybes without a separate flag.
+    /// A niche represents `None` by a bit pattern of the value's storage, which no valid value ever has.
+    /// Specializations implement:
+    /// - `static void setNone(T *storage)`, writing the pattern into storage not holding a value.
+    /// - `static bool isNone(T const *storage)`, checking for the pattern in storage holding either a value or the pattern.
+    /// Types can opt in by deriving the specialization from one of the niches below,
+    /// e.g. `template<> struct flow::MaybeNiche<Color>: flow::SentinelNiche<Color, Color::Invalid> {};`.
+    /// The specialization must be visible wherever `Maybe<T>` is used, like any template specialization.
+    template<class T, class = void>
+    struct MaybeNiche
+    {
+    };
+
+    namespace details
+    {
+        template<class T, class = void>
+        struct HasMaybeNiche: std::false_type
+        {
+        };
+
+        template<class T>
+        struct HasMaybeNiche<T, std::void_t<decltype(MaybeNiche<T>::isNone(std::declval<T const *>()))>>: std::true_type
+        {
+        };
+
+        /// Whether `None` is encoded into the value's storage.
+        template<class T>
+        static constexpr bool hasMaybeNiche = HasMaybeNiche<T>::value;
+
+        /// An address at the very top of the address space, which is reserved for the kernel on all common platforms.
+        /// Unlike null, this is never a pointer value used by programs, so null pointers remain values.
+        template<class T>
+        T *nichePointer()
+        {
+            return reinterpret_cast<T *>(~std::uintptr_t(0) << 6);
+        }
+    }
+
+    /// Represents `None` by a value which is otherwise not used, e.g. an enumerator like `Invalid`
+    /// or the maximum value of an index type.
+    template<class T, T sentinel>
+    struct SentinelNiche
+    {
+        static void setNone(T *storage)
+        {
+            new (storage) T(sentinel);
+        }
+
+        static bool isNone(T const *storage)
+        {
+            return *storage == sentinel;
+        }
+    };
+
+    /// Represents `None` of an unsigned index type by its maximum value.
+    template<class T>
+    struct MaxValueNiche: SentinelNiche<T, std::numeric_limits<T>::max()>
+    {
+        static_assert(std::is_unsigned_v<T>, "Only unsigned indices have a spare maximum value.");
+    };
+
+    /// Represents `None` of a floating point type by a NaN with a specific payload.
+    /// Other NaNs, including the ones produced by arithmetic, remain values.
+    template<class T>
+    struct NanNiche
+    {
+        static_assert(std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8),
+            "Only IEEE 754 floats and doubles are supported.");
+
+        using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+        /// A quiet NaN with a payload arithmetic does not produce.
+        static constexpr Bits noneBits = sizeof(T) == 4 ? Bits(0x7fc5a3e1) : Bits(0x7ff8f10ea3e1c0deull);
+
+        static void setNone(T *storage)
+        {
+            std::memcpy(storage, &noneBits, sizeof(T));
+        }
+
+        static bool isNone(T const *storage)
+        {
+            Bits bits;
+            std::memcpy(&bits, storage, sizeof(T));
+            return bits == noneBits;
+        }
+    };
+
+    /// Raw pointers represent `None` by an address programs do not use, see `details::nichePointer`.
+    template<class T>
+    struct MaybeNiche<T *>
+    {
+        static void setNone(T **storage)
+        {
+            *storage = details::nichePointer<T>();
+        }
+
+        static bool isNone(T *const *storage)
+        {
+            return *storage == details::nichePointer<T>();
+        }
+    };
+
+    /// Unique pointers with the default deleter consist of just the pointer,
+    /// whose storage is set to the same address as for raw pointers, without constructing a unique pointer.
+    template<class T>
+    struct MaybeNiche<std::unique_ptr<T>>
+    {
+        using Pointer = typename std::unique_ptr<T>::pointer;
+
+        static_assert(sizeof(std::unique_ptr<T>) == sizeof(Pointer));
+
+        static void setNone(std::unique_ptr<T> *storage)
+        {
+            Pointer sentinel = details::nichePointer<std::remove_pointer_t<Pointer>>();
+            std::memcpy(static_cast<void *>(storage), &sentinel, sizeof(Pointer));
+        }
+
+        static bool isNone(std::unique_ptr<T> const *storage)
+        {
+            Pointer pointer;
+            std::memcpy(&pointer, static_cast<void const *>(storage), sizeof(Pointer));
+            return pointer == details::nichePointer<std::remove_pointer_t<Pointer>>();
+        }
+    };
+
+    /// String views represent `None` by an empty view at the same address as raw pointers.
+    template<class C, class Traits>
+    struct MaybeNiche<std::basic_string_view<C, Traits>>
+    {
+        using View = std::basic_string_view<C, Traits>;
+
+        static void setNone(View *storage)
+        {
+            new (storage) View(details::nichePointer<C const>(), 0);
+        }
+
+        static bool isNone(View const *storage)
+        {
+            return storage->data() == details::nichePointer<C const>();
+        }
+    };
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <flow/Batch.h>
+#include <flow/Collect.h>
+#include <flow/details.h>
+#include <flow/Maybe.h>
+#include <flow/ParMap.h>
+#include <flow/SizeHint.h>
+
+namespace flow
+{
+    namespace details
+    {
+        /// Expands a single outer element into a buffer owned by the worker thread doing the expansion.
+        /// The element is kept alive during the expansion, so the function may return a sequence borrowing from it.
+        template<class F, class I>
+        struct Expand
+        {
+            using SubSequenceType = std::remove_cv_t<std::remove_reference_t<std::invoke_result_t<F &, I &>>>;
+            using ElementType = typename SubSequenceType::ElementType;
+
+            std::vector<ElementType> operator()(I input)
+            {
+                SubSequenceType subSequence = std::invoke(function, input);
+                std::vector<ElementType> buffer;
+                details::append(buffer, subSequence);
+                return buffer;
+            }
+
+            F function;
+        };
+    }
+
+    /// Maps each element to a sub sequence and yields the elements of all sub sequences,
+    /// like `flatMap`, but expands the elements on the threads of the shared pool.
+    /// Each worker expands one element at a time into its own buffer, which is handed to the consuming thread as a whole.
+    /// Idle workers take the next pending element from the queue of the stage,
+    /// so that a few large elements do not hold up the workers expanding small ones.
+    /// Up to `window` elements are expanded concurrently, which bounds the number of buffers held by this stage.
+    /// If `Ordered` is set, the sub sequences are yielded in the order of the base sequence,
+    /// otherwise in the order their expansion finishes; the elements of a single sub sequence always stay in order.
+    /// Exceptions and copies behave like in `parMap`.
+    /// Arity: 1 -> 1
+    template<class S, class F, bool Ordered>
+    class ParFlatMap
+    {
+        using Expand = details::Expand<F, std::remove_cv_t<std::remove_reference_t<typename S::ElementType>>>;
+        using Buffer = std::vector<typename Expand::ElementType>;
+
+    public:
+        using ElementType = typename Expand::ElementType;
+
+        static_assert(!std::is_reference_v<ElementType>, "Elements expanded on worker threads must be owned.");
+
+        ParFlatMap(S &&sequence, F function, size_t threads, size_t window):
+            buffers(std::move(sequence), Expand{std::move(function)}, threads, window)
+        {
+        }
+
+        Maybe<ElementType> next()
+        {
+            if (!fill())
+            {
+                return None();
+            }
+            return std::move(buffer[position++]);
+        }
+
+        /// Moves a block of the current buffer into the batch.
+        template<class E = ElementType, class = std::enable_if_t<details::isBatchable<E>>>
+        size_t nextBatch(Span<E> batch)
+        {
+            if (batch.size() == 0 || !fill())
+            {
+                return 0;
+            }
+            size_t count = std::min(batch.size(), buffer.size() - position);
+            std::move(buffer.begin() + position, buffer.begin() + position + count, batch.data());
+            position += count;
+            return count;
+        }
+
+        /// At least the rest of the current buffer is yielded.
+        SizeHint sizeHint() const
+        {
+            size_t remaining = buffer.size() - position;
+            SizeHint hint = flow::sizeHint(buffers);
+            if (hint.upper.hasValue() && hint.upper.value() == 0)
+            {
+                return SizeHint::exactly(remaining);
+            }
+            return SizeHint{remaining, None()};
+        }
+
+    private:
+        /// Makes sure the current buffer has an element left, skipping empty buffers.
+        /// Returns false if all buffers are consumed.
+        bool fill()
+        {
+            while (position == buffer.size())
+            {
+                Maybe<Buffer> nextBuffer = buffers.next();
+                if (!nextBuffer.hasValue())
+                {
+                    return false;
+                }
+                buffer = std::move(nextBuffer).value();
+                position = 0;
+            }
+            return true;
+        }
+
+        ParMap<S, Expand, Ordered> buffers;
+        Buffer buffer;
+        size_t position = 0;
+    };
+
+    /// Expands elements into sub sequences on up to `threads` threads of the shared pool, keeping the order of sub sequences.
+    /// Zero threads selects the number of hardware threads, and a zero window two elements per thread.
+    /// The function is called concurrently, so it must not modify shared state without synchronization.
+    /// It is moved into the stage, so it may be move-only.
+    template<class F>
+    auto parFlatMap(F function, size_t threads = 0, size_t window = 0)
+    {
+        return [function = std::move(function), threads, window] (auto &&sequence) mutable
+        {
+            using S = std::remove_reference_t<decltype(sequence)>;
+            return ParFlatMap<S, F, true>(std::move(sequence), std::move(function), threads, window);
+        };
+    }
+
+    /// Like `parFlatMap`, but yields the elements of each sub sequence as soon as it is expanded.
+    template<class F>
+    auto parFlatMapUnordered(F function, size_t threads = 0, size_t window = 0)
+    {
+        return [function = std::move(function), threads, window] (auto &&sequence) mutable
+        {
+            using S = std::remove_reference_t<decltype(sequence)>;
+            return ParFlatMap<S, F, false>(std::move(sequence), std::move(function), threads, window);
+        };
+    }
+
+    namespace details
+    {
+        struct Unwrap
+        {
+            template<class S>
+            S operator()(S &subSequence) const
+            {
+                return std::move(subSequence);
+            }
+        };
+    }
+
+    /// Iterates the sub sequences of the base sequence on worker threads, see `parFlatMap`.
+    inline auto parFlatten(size_t threads = 0, size_t window = 0)
+    {
+        return parFlatMap(details::Unwrap(), threads, window);
+    }
+}
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <flow/details.h>
+#include <flow/Maybe.h>
+#include <flow/Parallel.h>
+#include <flow/SizeHint.h>
+
+namespace flow
+{
+    namespace details
+    {
+        /// A mapped element, or the exception thrown while mapping it.
+        template<class T>
+        struct ParMapResult
+        {
+            Maybe<T> value = None();
+            std::exception_ptr error;
+
+            bool isReady() const
+            {
+                return value.hasValue() || error;
+            }
+        };
+
+        /// State shared between the consumer and the tasks running on the shared pool.
+        /// Tasks keep the state alive, so that tasks starting after the stage is dropped find nothing to map and return.
+        template<class F, class I, class T>
+        struct ParMapState
+        {
+            ParMapState(F &&function, size_t window, bool ordered):
+                function(std::move(function)),
+                reorderBuffer(ordered ? window : 0)
+            {
+            }
+
+            /// Maps the oldest pending input on the calling thread and stores its result.
+            /// The lock is released while mapping. Returns false if no input is pending.
+            bool mapPending(std::unique_lock<std::mutex> &lock)
+            {
+                if (pending.empty())
+                {
+                    return false;
+                }
+                std::pair<size_t, I> input = std::move(pending.front());
+                pending.pop_front();
+                ++mapping;
+                lock.unlock();
+
+                ParMapResult<T> result;
+                try
+                {
+                    details::reinitialize(result.value, Maybe<T>(std::invoke(function, std::move(input.second))));
+                }
+                catch (...)
+                {
+                    result.error = std::current_exception();
+                }
+
+                lock.lock();
+                --mapping;
+                if (reorderBuffer.empty())
+                {
+                    completed.push_back(std::move(result));
+                }
+                else
+                {
+                    ParMapResult<T> &slot = reorderBuffer[input.first % reorderBuffer.size()];
+                    details::reinitialize(slot.value, std::move(result.value));
+                    slot.error = result.error;
+                }
+                changed.notify_all();
+                return true;
+            }
+
+            F function;
+            std::mutex mutex;
+
+            /// Notified whenever an input is mapped.
+            std::condition_variable changed;
+
+            /// Inputs not yet taken by a task, each with the index of its position in the base sequence.
+            std::deque<std::pair<size_t, I>> pending;
+
+            /// The number of tasks scheduled on the shared pool, which may not have started yet.
+            size_t tasks = 0;
+
+            /// The number of inputs being mapped right now.
+            size_t mapping = 0;
+
+            /// Results of ordered stages, each one at the slot of its input's index modulo the window size.
+            std::vector<ParMapResult<T>> reorderBuffer;
+
+            /// Results of unordered stages in order of completion.
+            std::deque<ParMapResult<T>> completed;
+        };
+    }
+
+    /// Maps each sequence element through a function evaluated on the threads of the shared pool.
+    /// Up to `window` elements are pulled from the base sequence ahead and mapped concurrently by up to `threads` tasks,
+    /// which bounds the number of elements held by this stage.
+    /// If `Ordered` is set, mapped elements are yielded in the order of the base sequence,
+    /// otherwise in the order their mapping finishes.
+    /// The base sequence is only pulled from the consuming thread,
+    /// which maps pending elements itself while waiting, so stages may be nested in other parallel algorithms.
+    /// The function is invoked with each element as an rvalue, and references it returns are copied into owned elements.
+    /// Exceptions thrown by the function are rethrown by `next()` when the failed element would have been yielded.
+    /// Copies of this sequence do not share elements already in flight, so copy it before iterating.
+    /// Dropping it discards pending elements and waits for those being mapped.
+    /// Arity: 1 -> 1
+    template<class S, class F, bool Ordered>
+    class ParMap
+    {
+    public:
+        using FunctionInputType = typename S::ElementType;
+        using ElementType = std::remove_cv_t<std::remove_reference_t<std::invoke_result_t<F &, FunctionInputType>>>;
+
+        ParMap(S &&sequence, F function, size_t threads, size_t window):
+            sequence(std::move(sequence)),
+            threads(details::threadCount(threads)),
+            window(window != 0 ? window : 2 * this->threads),
+            state(std::make_shared<State>(std::move(function), this->window, Ordered))
+        {
+        }
+
+        ParMap(ParMap const &other):
+            sequence(other.sequence),
+            threads(other.threads),
+            window(other.window),
+            state(std::make_shared<State>(F(other.state->function), window, Ordered))
+        {
+        }
+
+        ParMap(ParMap &&other) = default;
+
+        ParMap &operator=(ParMap const &) = delete;
+        ParMap &operator=(ParMap &&) = delete;
+
+        ~ParMap()
+        {
+            if (state)
+            {
+                std::unique_lock<std::mutex> lock(state->mutex);
+                state->pending.clear();
+                state->changed.wait(lock, [this] { return state->mapping == 0; });
+            }
+        }
+
+        Maybe<ElementType> next()
+        {
+            while (!exhausted && submitted - yielded < window)
+            {
+                Maybe<FunctionInputType> input = sequence.next();
+                if (!input.hasValue())
+                {
+                    exhausted = true;
+                    break;
+                }
+                submit(std::move(input).value());
+            }
+
+            if (submitted == yielded)
+            {
+                return None();
+            }
+
+            std::unique_lock<std::mutex> lock(state->mutex);
+            details::ParMapResult<ElementType> *slot = nullptr;
+            for (;;)
+            {
+                if constexpr (Ordered)
+                {
+                    slot = &state->reorderBuffer[yielded % window];
+                }
+                else
+                {
+                    slot = state->completed.empty() ? nullptr : &state->completed.front();
+                }
+                if (slot && slot->isReady())
+                {
+                    break;
+                }
+                // Mapping pending elements instead of waiting makes progress even if all pool threads are busy.
+                if (!state->mapPending(lock))
+                {
+                    state->changed.wait(lock);
+                }
+            }
+
+            Maybe<ElementType> result(std::move(slot->value));
+            std::exception_ptr error = std::exchange(slot->error, nullptr);
+            if constexpr (Ordered)
+            {
+                details::reinitialize(slot->value, Maybe<ElementType>(None()));
+            }
+            else
+            {
+                state->completed.pop_front();
+            }
+            ++yielded;
+            lock.unlock();
+
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+            return result;
+        }
+
+        /// Elements in flight are counted in addition to the remaining base elements.
+        SizeHint sizeHint() const
+        {
+            SizeHint hint = flow::sizeHint(sequence);
+            size_t pending = submitted - yielded;
+            return SizeHint{
+                details::saturatingAdd(hint.lower, pending),
+                hint.upper.hasValue() ? Maybe<size_t>(details::saturatingAdd(hint.upper.value(), pending)) : None()
+            };
+        }
+
+    private:
+        using InputType = std::remove_cv_t<std::remove_reference_t<FunctionInputType>>;
+        using State = details::ParMapState<F, InputType, ElementType>;
+
+        /// Queues the input and schedules another task unless `threads` tasks are scheduled already.
+        /// Each task maps pending inputs until none is left.
+        void submit(InputType input)
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->pending.emplace_back(submitted++, std::move(input));
+            if (state->tasks < threads)
+            {
+                ++state->tasks;
+                details::sharedPool().submit([state = state]
+                {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    while (state->mapPending(lock))
+                    {
+                    }
+                    --state->tasks;
+                });
+            }
+        }
+
+        S sequence;
+        size_t threads;
+        size_t window;
+        std::shared_ptr<State> state;
+        size_t submitted = 0;
+        size_t yielded = 0;
+        bool exhausted = false;
+    };
+
+    /// Maps elements on up to `threads` threads of the shared pool, keeping the order of elements.
+    /// Zero threads selects the number of hardware threads, and a zero window two elements per thread.
+    /// The function is called concurrently, so it must not modify shared state without synchronization.
+    /// It is moved into the stage, so it may be move-only, and may also be a member pointer.
+    template<class F>
+    auto parMap(F function, size_t threads = 0, size_t window = 0)
+    {
+        return [function = std::move(function), threads, window] (auto &&sequence) mutable
+        {
+            using S = std::remove_reference_t<decltype(sequence)>;
+            return ParMap<S, F, true>(std::move(sequence), std::move(function), threads, window);
+        };
+    }
+
+    /// Like `parMap`, but yields elements as soon as they are mapped,
+    /// so that a slow element does not hold back faster ones.
+    template<class F>
+    auto parMapUnordered(F function, size_t threads = 0, size_t window = 0)
+    {
+        return [function = std::move(function), threads, window] (auto &&sequence) mutable
+        {
+            using S = std::remove_reference_t<decltype(sequence)>;
+            return ParMap<S, F, false>(std::move(sequence), std::move(function), threads, window);
+        };
+    }
+}
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <flow/ElementsOf.h>
+#include <flow/Fold.h>
+#include <flow/Maybe.h>
+#include <flow/Reductions.h>
+#include <flow/Simd.h>
+#include <flow/Slice.h>
+#include <flow/ThreadPool.h>
+
+namespace flow
+{
+    /// Controls how parallel algorithms divide the work.
+    struct ParallelOptions
+    {
+        /// The number of threads to use, including the calling thread.
+        /// Zero selects the number of hardware threads, which is also the maximum.
+        size_t threads = 0;
+
+        /// The number of positions reduced by a single task.
+        /// Zero divides the sequence into four chunks per thread, which balances uneven chunks reasonably well.
+        size_t chunkSize = 0;
+    };
+
+    namespace details
+    {
+        /// Resolves a requested number of threads, where zero selects the number of hardware threads.
+        inline size_t threadCount(size_t requested)
+        {
+            if (requested != 0)
+            {
+                return requested;
+            }
+            return std::max(size_t(1), static_cast<size_t>(std::thread::hardware_concurrency()));
+        }
+
+        inline size_t chunkSize(ParallelOptions const &options, size_t positions, size_t threads)
+        {
+            if (options.chunkSize != 0)
+            {
+                return options.chunkSize;
+            }
+            size_t chunks = threads * 4;
+            return std::max(size_t(1), (positions + chunks - 1) / chunks);
+        }
+
+        /// The helper threads of all parallel algorithms, which are started on first use and kept until the program exits.
+        /// Together with the calling thread, there is one thread per hardware thread.
+        inline ThreadPool &sharedPool()
+        {
+            static ThreadPool pool(std::max(size_t(1), threadCount(0) - 1));
+            return pool;
+        }
+
+        /// Calls `work(chunk)` for each chunk index on up to `threads` threads, including the calling thread,
+        /// but on no more helper threads than the shared pool holds.
+        /// Chunks are taken in increasing order from a shared counter, so that uneven chunks are balanced.
+        /// The calling thread only waits for chunks already being worked on, never for helpers to be scheduled,
+        /// so that parallel algorithms may be nested. Helpers starting after all chunks are taken return right away.
+        /// The first exception thrown by `work` is rethrown once all chunks are finished.
+        template<class W>
+        void forEachChunk(size_t chunks, size_t threads, W const &work)
+        {
+            struct Progress
+            {
+                std::atomic<size_t> nextChunk{0};
+                size_t finishedChunks = 0;
+                std::exception_ptr error;
+                std::mutex mutex;
+                std::condition_variable finished;
+            };
+
+            if (chunks == 0)
+            {
+                return;
+            }
+
+            // Helpers may outlive this call, so they share the progress instead of borrowing it.
+            auto progress = std::make_shared<Progress>();
+            auto worker = [progress, chunks, &work]
+            {
+                for (size_t chunk = progress->nextChunk++; chunk < chunks; chunk = progress->nextChunk++)
+                {
+                    std::exception_ptr error;
+                    try
+                    {
+                        work(chunk);
+                    }
+                    catch (...)
+                    {
+                        error = std::current_exception();
+                    }
+
+                    std::lock_guard<std::mutex> lock(progress->mutex);
+                    if (error && !progress->error)
+                    {
+                        progress->error = error;
+                    }
+                    if (++progress->finishedChunks == chunks)
+                    {
+                        progress->finished.notify_all();
+                    }
+                }
+            };
+
+            size_t helpers = std::min(threads, chunks) - 1;
+            if (helpers > 0)
+            {
+                ThreadPool &pool = sharedPool();
+                for (size_t i = 0; i < std::min(helpers, pool.size()); ++i)
+                {
+                    pool.submit(worker);
+                }
+            }
+
+            // The calling thread takes chunks as well, instead of idling until the helpers are done.
+            worker();
+
+            std::unique_lock<std::mutex> lock(progress->mutex);
+            progress->finished.wait(lock, [&] { return progress->finishedChunks == chunks; });
+            if (progress->error)
+            {
+                std::rethrow_exception(progress->error);
+            }
+        }
+
+        /// The number of positions summed by a single task of `parallelSum`.
+        /// It is fixed, so that the summation tree only depends on the sequence size.
+        static constexpr size_t sumChunkSize = 64 * simd::pairwiseBlockSize;
+    }
+
+    /// Reduces the sequence on multiple threads.
+    /// The sequence is sliced into chunks of consecutive positions, see `Slice.h`.
+    /// Contiguous sequences are folded straight from their storage instead.
+    /// Each chunk is folded by `op(accumulator, element)` starting at a copy of `identity`,
+    /// after which the chunk results are merged in order by `combine(left, right)`.
+    /// Both functions must be associative with `identity` as neutral element for the result to equal a sequential fold.
+    /// Since the chunk boundaries only depend on the sequence size and the options, and chunk results are always combined
+    /// in the same order, the result is deterministic for given options, even for non-associative operations
+    /// like floating point addition.
+    /// The functions are called concurrently, so they must not modify shared state without synchronization.
+    template<class S, class T, class F, class C>
+    T parallelReduce(S const &sequence, T identity, F op, C combine, ParallelOptions options = {})
+    {
+        static_assert(details::isSliceable<S>, "Parallel reductions require a sliceable sequence, e.g. `elements` or `elementsOf` of a vector.");
+
+        size_t positions = slicePositions(sequence);
+        size_t threads = details::threadCount(options.threads);
+        size_t chunkSize = details::chunkSize(options, positions, threads);
+        size_t chunks = (positions + chunkSize - 1) / chunkSize;
+
+        if (chunks == 0)
+        {
+            return identity;
+        }
+
+        std::vector<Maybe<T>> results(chunks, Maybe<T>(None()));
+        details::forEachChunk(chunks, threads, [&] (size_t chunk)
+        {
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(positions, begin + chunkSize);
+            if constexpr (details::isContiguous<S>)
+            {
+                // Folds straight from the storage, instead of slicing owning sequences like `elements` into copies.
+                results[chunk] = Maybe<T>(fold(elementsOf(sequence.data() + begin, end - begin), identity, op));
+            }
+            else
+            {
+                results[chunk] = Maybe<T>(fold(sequence.slice(begin, end), identity, op));
+            }
+        });
+
+        T result = std::move(results[0]).value();
+        for (size_t chunk = 1; chunk < chunks; ++chunk)
+        {
+            details::reinitialize(result, combine(std::move(result), std::move(results[chunk]).value()));
+        }
+        return result;
+    }
+
+    /// Like `parallelReduce`, with the folding function also combining the chunk results,
+    /// e.g. `parallelFold(elementsOf(v), 0, std::plus<>())`.
+    template<class S, class T, class F>
+    T parallelFold(S const &sequence, T identity, F op, ParallelOptions options = {})
+    {
+        return parallelReduce(sequence, std::move(identity), op, op, options);
+    }
+
+    /// Sums the elements of a sliceable sequence of arithmetic elements on multiple threads.
+    /// The result is bit-for-bit reproducible, independent of the number of threads and the scheduling:
+    /// The sequence is divided into chunks of a fixed size, each summed by `sum`,
+    /// i.e. pairwise by the vectorized kernels for contiguous and batched sequences,
+    /// after which the chunk sums are summed pairwise in chunk order.
+    /// Floating point rounding errors therefore grow logarithmically in the number of elements, as for `sum`.
+    /// Zero threads selects the number of hardware threads.
+    /// Integers narrower than `int` are summed as `int`, like by `sum`.
+    template<class S>
+    details::simd::SumType<details::ValueType<S>> parallelSum(S const &sequence, size_t threads = 0)
+    {
+        static_assert(details::isSliceable<S>, "Parallel sums require a sliceable sequence, e.g. `elements` or `elementsOf` of a vector.");
+        static_assert(details::isReducible<S>, "Parallel sums require arithmetic elements.");
+
+        using T = details::ValueType<S>;
+
+        size_t positions = slicePositions(sequence);
+        size_t chunks = (positions + details::sumChunkSize - 1) / details::sumChunkSize;
+
+        std::vector<details::simd::SumType<T>> sums(chunks);
+        details::forEachChunk(chunks, details::threadCount(threads), [&] (size_t chunk)
+        {
+            size_t begin = chunk * details::sumChunkSize;
+            size_t end = std::min(positions, begin + details::sumChunkSize);
+            if constexpr (details::isContiguous<S>)
+            {
+                // Sums straight from the storage, instead of slicing owning sequences like `elements` into copies.
+                sums[chunk] = details::simd::sum(sequence.data() + begin, end - begin);
+            }
+            else
+            {
+                sums[chunk] = sum(sequence.slice(begin, end));
+            }
+        });
+
+        return details::simd::sum(sums.data(), sums.size());
+    }
+}
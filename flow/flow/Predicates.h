@@ -0,0 +1,192 @@
+#pragma once
+
+#include <flow/Simd.h>
+
+namespace flow
+{
+    /// Comparison predicates, which may be evaluated on whole vectors of elements.
+    /// When used with `filter` over floats, doubles or 32 bit integers of the same type as the bound,
+    /// blocks of elements are filtered by the vectorized compaction kernels instead of element by element.
+    /// Any other element type comparable to the bound is filtered by the plain comparison.
+    /// The kernels only need to know how each predicate bounds the accepted elements from below and above.
+
+    template<class T>
+    struct LessThan
+    {
+        using ValueType = T;
+        static constexpr bool isVectorizable = true;
+        static constexpr details::simd::Bound lowerBound = details::simd::Bound::none;
+        static constexpr details::simd::Bound upperBound = details::simd::Bound::open;
+
+        T bound;
+
+        template<class U>
+        bool operator()(U const &element) const
+        {
+            return element < bound;
+        }
+
+        T upperValue() const
+        {
+            return bound;
+        }
+    };
+
+    template<class T>
+    struct LessEqual
+    {
+        using ValueType = T;
+        static constexpr bool isVectorizable = true;
+        static constexpr details::simd::Bound lowerBound = details::simd::Bound::none;
+        static constexpr details::simd::Bound upperBound = details::simd::Bound::closed;
+
+        T bound;
+
+        template<class U>
+        bool operator()(U const &element) const
+        {
+            return element <= bound;
+        }
+
+        T upperValue() const
+        {
+            return bound;
+        }
+    };
+
+    template<class T>
+    struct GreaterThan
+    {
+        using ValueType = T;
+        static constexpr bool isVectorizable = true;
+        static constexpr details::simd::Bound lowerBound = details::simd::Bound::open;
+        static constexpr details::simd::Bound upperBound = details::simd::Bound::none;
+
+        T bound;
+
+        template<class U>
+        bool operator()(U const &element) const
+        {
+            return bound < element;
+        }
+
+        T lowerValue() const
+        {
+            return bound;
+        }
+    };
+
+    template<class T>
+    struct GreaterEqual
+    {
+        using ValueType = T;
+        static constexpr bool isVectorizable = true;
+        static constexpr details::simd::Bound lowerBound = details::simd::Bound::closed;
+        static constexpr details::simd::Bound upperBound = details::simd::Bound::none;
+
+        T bound;
+
+        template<class U>
+        bool operator()(U const &element) const
+        {
+            return bound <= element;
+        }
+
+        T lowerValue() const
+        {
+            return bound;
+        }
+    };
+
+    template<class T>
+    struct EqualTo
+    {
+        using ValueType = T;
+        static constexpr bool isVectorizable = true;
+        static constexpr details::simd::Bound lowerBound = details::simd::Bound::closed;
+        static constexpr details::simd::Bound upperBound = details::simd::Bound::closed;
+
+        T value;
+
+        template<class U>
+        bool operator()(U const &element) const
+        {
+            return element == value;
+        }
+
+        T lowerValue() const
+        {
+            return value;
+        }
+
+        T upperValue() const
+        {
+            return value;
+        }
+    };
+
+    /// Accepts elements within the closed interval `[lower, upper]`.
+    template<class T>
+    struct Between
+    {
+        using ValueType = T;
+        static constexpr bool isVectorizable = true;
+        static constexpr details::simd::Bound lowerBound = details::simd::Bound::closed;
+        static constexpr details::simd::Bound upperBound = details::simd::Bound::closed;
+
+        T lower;
+        T upper;
+
+        template<class U>
+        bool operator()(U const &element) const
+        {
+            return lower <= element && element <= upper;
+        }
+
+        T lowerValue() const
+        {
+            return lower;
+        }
+
+        T upperValue() const
+        {
+            return upper;
+        }
+    };
+
+    template<class T>
+    LessThan<T> lessThan(T bound)
+    {
+        return LessThan<T>{bound};
+    }
+
+    template<class T>
+    LessEqual<T> lessEqual(T bound)
+    {
+        return LessEqual<T>{bound};
+    }
+
+    template<class T>
+    GreaterThan<T> greaterThan(T bound)
+    {
+        return GreaterThan<T>{bound};
+    }
+
+    template<class T>
+    GreaterEqual<T> greaterEqual(T bound)
+    {
+        return GreaterEqual<T>{bound};
+    }
+
+    template<class T>
+    EqualTo<T> equalTo(T value)
+    {
+        return EqualTo<T>{value};
+    }
+
+    template<class T>
+    Between<T> between(T lower, T upper)
+    {
+        return Between<T>{lower, upper};
+    }
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <flow/Flow.h>
+#include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/Slice.h>
+#include <flow/Span.h>
+#include <flow/TryFold.h>
+
+namespace flow
+{
+    namespace details
+    {
+        using PhiloxBlock = std::array<uint32_t, 4>;
+
+        /// The counter-based generator Philox4x32-10 by Salmon et al., "Parallel random numbers: as easy as 1, 2, 3".
+        /// It maps a counter and a key to 128 random bits without any state,
+        /// so that the `n`-th block of a stream is computed as fast as the next one.
+        inline PhiloxBlock philox(uint64_t counter, uint64_t seed)
+        {
+            uint32_t c0 = static_cast<uint32_t>(counter);
+            uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+            uint32_t c2 = 0;
+            uint32_t c3 = 0;
+            uint32_t k0 = static_cast<uint32_t>(seed);
+            uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+
+            for (int round = 0; round < 10; ++round)
+            {
+                uint64_t p0 = uint64_t(0xD2511F53) * c0;
+                uint64_t p1 = uint64_t(0xCD9E8D57) * c2;
+                uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+                uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+                c1 = static_cast<uint32_t>(p1);
+                c3 = static_cast<uint32_t>(p0);
+                c0 = n0;
+                c2 = n2;
+                k0 += 0x9E3779B9;
+                k1 += 0xBB67AE85;
+            }
+
+            return PhiloxBlock{c0, c1, c2, c3};
+        }
+
+        /// Converts random bits into a number in `[0, 1)`, using as many bits as the mantissa holds.
+        template<class T>
+        T unitInterval(uint64_t bits)
+        {
+            constexpr int digits = std::numeric_limits<T>::digits;
+            return static_cast<T>(bits >> (64 - digits)) * (T(1) / static_cast<T>(uint64_t(1) << digits));
+        }
+
+        inline uint64_t word(PhiloxBlock const &block, size_t i)
+        {
+            return uint64_t(block[2 * i]) | (uint64_t(block[2 * i + 1]) << 32);
+        }
+
+        /// Distributions turn each block into two elements, one from each 64-bit half.
+        struct UniformBits
+        {
+            using ResultType = uint64_t;
+
+            void operator()(PhiloxBlock const &block, uint64_t *elements) const
+            {
+                elements[0] = word(block, 0);
+                elements[1] = word(block, 1);
+            }
+        };
+
+        template<class T>
+        struct UniformDistribution
+        {
+            using ResultType = T;
+
+            T low;
+            T high;
+            /// The largest number below `high`, since `low + u * (high - low)` may round up to `high`.
+            T largest;
+
+            void operator()(PhiloxBlock const &block, T *elements) const
+            {
+                elements[0] = std::min(low + unitInterval<T>(word(block, 0)) * (high - low), largest);
+                elements[1] = std::min(low + unitInterval<T>(word(block, 1)) * (high - low), largest);
+            }
+        };
+
+        /// Uses the Box-Muller transform on both halves of the block, which yields two independent normal numbers.
+        template<class T>
+        struct NormalDistribution
+        {
+            using ResultType = T;
+
+            T mean;
+            T deviation;
+
+            void operator()(PhiloxBlock const &block, T *elements) const
+            {
+                // Avoids the logarithm of zero by mapping to `(0, 1]`.
+                T radius = deviation * std::sqrt(T(-2) * std::log(T(1) - unitInterval<T>(word(block, 0))));
+                T angle = T(6.283185307179586476925) * unitInterval<T>(word(block, 1));
+                elements[0] = mean + radius * std::cos(angle);
+                elements[1] = mean + radius * std::sin(angle);
+            }
+        };
+    }
+
+    /// Yields random numbers, where the element at position `i` is computed from the seed and `i` alone:
+    /// the block for the counter `i / 2` yields the elements at positions `2 * (i / 2)` and `2 * (i / 2) + 1`. Therefore, skipping, slicing and splitting take constant time,
+    /// and a given seed yields the same elements regardless of how the sequence is divided among threads.
+    /// Batches are filled by a loop without dependencies between blocks, computing each block once for two elements.
+    /// Arity: 0 -> 1
+    template<class D>
+    class Random
+    {
+    public:
+        using ElementType = typename D::ResultType;
+
+        static constexpr bool isExactlySliceable = true;
+
+        Random(uint64_t seed, D distribution, size_t position, size_t end):
+            seed(seed),
+            distribution(distribution),
+            position(position),
+            end(end)
+        {
+        }
+
+        Maybe<ElementType> next()
+        {
+            if (position != end)
+            {
+                return at(position++);
+            }
+            else
+            {
+                return None();
+            }
+        }
+
+        size_t nextBatch(Span<ElementType> batch)
+        {
+            size_t count = std::min(batch.size(), remaining());
+            ElementType *data = batch.data();
+            size_t k = 0;
+            if (count != 0 && position % 2 != 0)
+            {
+                data[k++] = at(position);
+            }
+            for (; k + 2 <= count; k += 2)
+            {
+                distribution(details::philox((position + k) / 2, seed), data + k);
+            }
+            if (k != count)
+            {
+                data[k] = at(position + k);
+            }
+            position += count;
+            return count;
+        }
+
+        size_t advanceBy(size_t n)
+        {
+            size_t skipped = std::min(n, remaining());
+            position += skipped;
+            return skipped;
+        }
+
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            while (position != end)
+            {
+                if (!function(accumulator, at(position++)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        SizeHint sizeHint() const
+        {
+            return SizeHint::exactly(remaining());
+        }
+
+        Random slice(size_t begin, size_t end) const
+        {
+            return Random(seed, distribution, position + begin, position + end);
+        }
+
+    private:
+        size_t remaining() const
+        {
+            return end - position;
+        }
+
+        ElementType at(size_t i) const
+        {
+            ElementType elements[2];
+            distribution(details::philox(i / 2, seed), elements);
+            return elements[i % 2];
+        }
+
+        uint64_t seed;
+        D distribution;
+        size_t position;
+        size_t end;
+    };
+
+    /// Yields `count` uniformly distributed 64-bit integers.
+    inline auto randomBits(uint64_t seed, size_t count)
+    {
+        return Flow(Random<details::UniformBits>(seed, details::UniformBits{}, 0, count));
+    }
+
+    /// Yields `count` floating point numbers, uniformly distributed in `[low, high)`.
+    template<class T = double>
+    auto randomUniform(uint64_t seed, size_t count, T low = T(0), T high = T(1))
+    {
+        static_assert(std::is_floating_point_v<T>, "Uniform random numbers are floating point numbers.");
+        return Flow(Random<details::UniformDistribution<T>>(seed, details::UniformDistribution<T>{low, high, std::nextafter(high, low)}, 0, count));
+    }
+
+    /// Yields `count` normally distributed floating point numbers.
+    template<class T = double>
+    auto randomNormal(uint64_t seed, size_t count, T mean = T(0), T deviation = T(1))
+    {
+        static_assert(std::is_floating_point_v<T>, "Normal random numbers are floating point numbers.");
+        return Flow(Random<details::NormalDistribution<T>>(seed, details::NormalDistribution<T>{mean, deviation}, 0, count));
+    }
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include <flow/Flow.h>
+#include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/Slice.h>
+#include <flow/Span.h>
+#include <flow/TryFold.h>
+
+namespace flow
+{
+    /// Yields the arithmetic progression `first, first + step, first + 2 * step, ...` up to a fixed number of elements.
+    /// Each element is computed from its position instead of by repeated addition,
+    /// so that floating point ranges do not accumulate rounding errors, and any element is reachable in constant time.
+    /// The sequence is just a handful of numbers and therefore trivially copyable.
+    template<class T>
+    class Range
+    {
+    public:
+        static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "Ranges consist of integers or floating point numbers.");
+
+        using ElementType = T;
+
+        static constexpr bool isExactlySliceable = true;
+
+        Range(T first, T step, size_t position, size_t end):
+            first(first),
+            step(step),
+            position(position),
+            end(end)
+        {
+        }
+
+        Maybe<ElementType> next()
+        {
+            if (position != end)
+            {
+                return at(position++);
+            }
+            else
+            {
+                return None();
+            }
+        }
+
+        /// Computes the elements independently of each other, which compilers vectorize.
+        size_t nextBatch(Span<ElementType> batch)
+        {
+            size_t count = std::min(batch.size(), remaining());
+            T *data = batch.data();
+            for (size_t k = 0; k < count; ++k)
+            {
+                data[k] = at(position + k);
+            }
+            position += count;
+            return count;
+        }
+
+        size_t advanceBy(size_t n)
+        {
+            size_t skipped = std::min(n, remaining());
+            position += skipped;
+            return skipped;
+        }
+
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            while (position != end)
+            {
+                if (!function(accumulator, at(position++)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        SizeHint sizeHint() const
+        {
+            return SizeHint::exactly(remaining());
+        }
+
+        Range slice(size_t begin, size_t end) const
+        {
+            return Range(first, step, position + begin, position + end);
+        }
+
+    private:
+        size_t remaining() const
+        {
+            return end - position;
+        }
+
+        /// Integers are computed in unsigned arithmetic, which wraps instead of overflowing
+        /// for intermediate products of signed ranges.
+        T at(size_t i) const
+        {
+            if constexpr (std::is_integral_v<T>)
+            {
+                using U = std::make_unsigned_t<T>;
+                return static_cast<T>(static_cast<U>(first) + static_cast<U>(i) * static_cast<U>(step));
+            }
+            else
+            {
+                return first + static_cast<T>(i) * step;
+            }
+        }
+
+        T first;
+        T step;
+        size_t position;
+        size_t end;
+    };
+
+    namespace details
+    {
+        /// The number of elements of `begin, begin + step, ...` which are before `end`.
+        template<class T>
+        size_t rangeSize(T begin, T end, T step)
+        {
+            if constexpr (std::is_integral_v<T>)
+            {
+                using U = std::make_unsigned_t<T>;
+                if (step > 0 && begin < end)
+                {
+                    U distance = static_cast<U>(static_cast<U>(end) - static_cast<U>(begin));
+                    return static_cast<size_t>((distance - 1) / static_cast<U>(step) + 1);
+                }
+                if (step < 0 && end < begin)
+                {
+                    U distance = static_cast<U>(static_cast<U>(begin) - static_cast<U>(end));
+                    return static_cast<size_t>((distance - 1) / (U(0) - static_cast<U>(step)) + 1);
+                }
+                return 0;
+            }
+            else
+            {
+                if (step == T(0))
+                {
+                    return 0;
+                }
+                T count = std::ceil((end - begin) / step);
+                // Also rejects NaN bounds.
+                if (!(count > 0))
+                {
+                    return 0;
+                }
+                // Converting counts size_t cannot represent is undefined, so infinite ranges like `range(0.0, INFINITY)`
+                // and huge ones are clamped to the largest size.
+                if (count >= static_cast<T>(std::numeric_limits<size_t>::max()))
+                {
+                    return std::numeric_limits<size_t>::max();
+                }
+                return static_cast<size_t>(count);
+            }
+        }
+    }
+
+    /// Yields the numbers from `begin` up to, but excluding, `end`, e.g. `range(0, n)`.
+    /// The element type is the common type of both bounds.
+    template<class B, class E>
+    auto range(B begin, E end)
+    {
+        using T = std::common_type_t<B, E>;
+        return Flow(Range<T>(T(begin), T(1), 0, details::rangeSize(T(begin), T(end), T(1))));
+    }
+
+    /// Yields the numbers from `begin` in increments of `step`, as long as they are before `end`,
+    /// e.g. `range(10, 0, -2)` yields `10, 8, 6, 4, 2`.
+    /// Descending ranges require a signed element type. A zero step yields no elements.
+    template<class B, class E>
+    auto range(B begin, E end, std::common_type_t<B, E> step)
+    {
+        using T = std::common_type_t<B, E>;
+        return Flow(Range<T>(T(begin), step, 0, details::rangeSize(T(begin), T(end), step)));
+    }
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <cstdint>
+
+#include <flow/Batch.h>
+#include <flow/details.h>
+#include <flow/Fold.h>
+#include <flow/Maybe.h>
+#include <flow/Simd.h>
+#include <flow/TryFold.h>
+#include <flow/Zip.h>
+
+namespace flow
+{
+    namespace details
+    {
+        template<class S>
+        using ValueType = std::remove_cv_t<std::remove_reference_t<typename S::ElementType>>;
+
+        /// Whether the sequence's elements can be reduced by the vectorized kernels,
+        /// either directly from its storage or block by block.
+        template<class S>
+        static constexpr bool isReducible = std::is_arithmetic_v<ValueType<S>>
+            && std::is_same_v<ValueType<S>, typename S::ElementType>;
+
+        /// Sums a stream of block sums pairwise, like a binary counter.
+        /// Each level holds the sum of `2^level` blocks, so rounding errors grow logarithmically in the number of blocks.
+        template<class T>
+        class PairwiseAccumulator
+        {
+        public:
+            void add(T blockSum)
+            {
+                size_t level = 0;
+                for (; occupied & (uint64_t(1) << level); ++level)
+                {
+                    blockSum = levels[level] + blockSum;
+                    occupied &= ~(uint64_t(1) << level);
+                }
+                levels[level] = blockSum;
+                occupied |= uint64_t(1) << level;
+            }
+
+            T result() const
+            {
+                T total = T();
+                for (size_t level = 0; level < 64; ++level)
+                {
+                    if (occupied & (uint64_t(1) << level))
+                    {
+                        total = levels[level] + total;
+                    }
+                }
+                return total;
+            }
+
+        private:
+            T levels[64];
+            uint64_t occupied = 0;
+        };
+
+        /// Pulls the sequence in blocks and passes each non-empty block to the given function.
+        template<class S, class F>
+        void forEachBlock(S &sequence, F &&function)
+        {
+            using T = typename S::ElementType;
+            T block[simd::pairwiseBlockSize];
+            while (size_t count = flow::nextBatch(sequence, Span<T>(block)))
+            {
+                function(static_cast<T const *>(block), count);
+            }
+        }
+    }
+
+    /// Sums all elements of the sequence, starting at a value-initialized element.
+    /// Arithmetic elements are summed by vectorized kernels, directly from the storage of contiguous sequences
+    /// and block by block from sequences implementing the batch protocol, e.g. `map` over a contiguous sequence.
+    /// Floating point elements are summed pairwise, see `details::simd::sum`.
+    /// Integers narrower than `int`, including `bool` and `char`, are summed as `int`.
+    template<class S>
+    auto sum(S sequence)
+    {
+        using T = details::ValueType<S>;
+        using R = details::simd::SumType<T>;
+
+        if constexpr (details::isReducible<S>)
+        {
+            if constexpr (details::isContiguous<S>)
+            {
+                return details::simd::sum(sequence.data(), sequence.size());
+            }
+            else if constexpr (details::hasNextBatch<S>)
+            {
+                details::PairwiseAccumulator<R> acc;
+                details::forEachBlock(sequence, [&] (T const *block, size_t count)
+                {
+                    acc.add(details::simd::sum(block, count));
+                });
+                return acc.result();
+            }
+        }
+
+        return fold(std::move(sequence), R(), [] (R acc, T const &element) { return acc + element; });
+    }
+
+    /// Returns the smallest element, or `None` if the sequence is empty.
+    /// The result is unspecified if floating point elements contain NaNs.
+    template<class S>
+    Maybe<details::ValueType<S>> min(S sequence)
+    {
+        using T = details::ValueType<S>;
+
+        if constexpr (details::isReducible<S>)
+        {
+            if constexpr (details::isContiguous<S>)
+            {
+                if (sequence.size() == 0)
+                {
+                    return None();
+                }
+                return details::simd::min(sequence.data(), sequence.size());
+            }
+            else if constexpr (details::hasNextBatch<S>)
+            {
+                Maybe<T> result = None();
+                details::forEachBlock(sequence, [&] (T const *block, size_t count)
+                {
+                    T blockMinimum = details::simd::min(block, count);
+                    result = Maybe<T>(result.hasValue() ? details::simd::Min::combine(result.value(), blockMinimum) : blockMinimum);
+                });
+                return result;
+            }
+        }
+
+        return fold(std::move(sequence), [] (T acc, T const &element) { return element < acc ? element : acc; });
+    }
+
+    /// Returns the largest element, or `None` if the sequence is empty.
+    /// The result is unspecified if floating point elements contain NaNs.
+    template<class S>
+    Maybe<details::ValueType<S>> max(S sequence)
+    {
+        using T = details::ValueType<S>;
+
+        if constexpr (details::isReducible<S>)
+        {
+            if constexpr (details::isContiguous<S>)
+            {
+                if (sequence.size() == 0)
+                {
+                    return None();
+                }
+                return details::simd::max(sequence.data(), sequence.size());
+            }
+            else if constexpr (details::hasNextBatch<S>)
+            {
+                Maybe<T> result = None();
+                details::forEachBlock(sequence, [&] (T const *block, size_t count)
+                {
+                    T blockMaximum = details::simd::max(block, count);
+                    result = Maybe<T>(result.hasValue() ? details::simd::Max::combine(result.value(), blockMaximum) : blockMaximum);
+                });
+                return result;
+            }
+        }
+
+        return fold(std::move(sequence), [] (T acc, T const &element) { return acc < element ? element : acc; });
+    }
+
+    /// Returns the smallest and the largest element in a single pass, or `None` if the sequence is empty.
+    /// The result is unspecified if floating point elements contain NaNs.
+    template<class S>
+    Maybe<std::pair<details::ValueType<S>, details::ValueType<S>>> minmax(S sequence)
+    {
+        using T = details::ValueType<S>;
+        using Pair = std::pair<T, T>;
+
+        if constexpr (details::isReducible<S>)
+        {
+            if constexpr (details::isContiguous<S>)
+            {
+                if (sequence.size() == 0)
+                {
+                    return None();
+                }
+                return details::simd::minmax(sequence.data(), sequence.size());
+            }
+            else if constexpr (details::hasNextBatch<S>)
+            {
+                Maybe<Pair> result = None();
+                details::forEachBlock(sequence, [&] (T const *block, size_t count)
+                {
+                    Pair blockBounds = details::simd::minmax(block, count);
+                    if (result.hasValue())
+                    {
+                        blockBounds.first = details::simd::Min::combine(result.value().first, blockBounds.first);
+                        blockBounds.second = details::simd::Max::combine(result.value().second, blockBounds.second);
+                    }
+                    result = blockBounds;
+                });
+                return result;
+            }
+        }
+
+        Maybe<typename S::ElementType> first = sequence.next();
+        if (!first.hasValue())
+        {
+            return None();
+        }
+
+        Pair bounds(first.value(), first.value());
+        flow::tryFold(sequence, bounds, [] (Pair &bounds, typename S::ElementType &&element)
+        {
+            if (element < bounds.first)
+            {
+                bounds.first = element;
+            }
+            if (bounds.second < element)
+            {
+                bounds.second = element;
+            }
+            return true;
+        });
+        return bounds;
+    }
+
+    /// Returns the sum of the pairwise products of the elements of both sequences.
+    /// Surplus elements of the longer sequence are ignored.
+    /// If both sequences are contiguous, the product is computed by a vectorized kernel,
+    /// pairwise over blocks for floating point elements.
+    template<class L, class R>
+    auto dot(L left, R right)
+    {
+        using T = details::ValueType<L>;
+
+        if constexpr (details::isReducible<L> && details::isContiguous<L> && details::isContiguous<R>
+            && std::is_same_v<details::ValueType<R>, T>)
+        {
+            return details::simd::dot(left.data(), right.data(), std::min(left.size(), right.size()));
+        }
+        else
+        {
+            using Pair = typename Zip<L, R>::ElementType;
+            return fold(Zip(std::move(left), std::move(right)), T(), [] (T acc, Pair const &pair)
+            {
+                return acc + pair.first * pair.second;
+            });
+        }
+    }
+}
@@ -0,0 +1,726 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define FLOW_SIMD_X86 1
+#include <immintrin.h>
+/// Compiles the AVX2 lane operations.
+#define FLOW_TARGET_AVX2 __attribute__((target("avx2")))
+/// Compiles an entry point instantiating a generic kernel for AVX2 lane operations,
+/// into which the kernel and its lane operations are inlined in optimized builds.
+#define FLOW_ENTRY_AVX2 __attribute__((target("avx2"), flatten))
+#else
+#define FLOW_SIMD_X86 0
+#endif
+
+/// Reduction and compaction kernels over raw contiguous ranges of arithmetic elements.
+/// Floats, doubles and 32 bit integers are processed by explicitly vectorized kernels,
+/// which use AVX2 if the executing CPU supports it and SSE2 otherwise.
+/// All other element types are processed by scalar kernels.
+namespace flow::details::simd
+{
+    /// Floating point ranges are summed directly within blocks of this size, whose sums are then added pairwise.
+    static constexpr size_t pairwiseBlockSize = 256;
+
+    /// How a vectorizable predicate bounds the accepted elements on one side.
+    enum class Bound
+    {
+        none,
+        open,
+        closed,
+    };
+
+    struct Add
+    {
+        template<class T>
+        static T combine(T a, T b)
+        {
+            return a + b;
+        }
+    };
+
+    struct Min
+    {
+        template<class T>
+        static T combine(T a, T b)
+        {
+            return b < a ? b : a;
+        }
+    };
+
+    struct Max
+    {
+        template<class T>
+        static T combine(T a, T b)
+        {
+            return a < b ? b : a;
+        }
+    };
+
+    /// Reduces with four independent accumulators, so the compiler is free to vectorize the loop.
+    template<class Op, class T>
+    T reduceScalar(T const *data, size_t size, T identity)
+    {
+        T acc[4] = {identity, identity, identity, identity};
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            for (size_t k = 0; k < 4; ++k)
+            {
+                acc[k] = Op::combine(acc[k], data[i + k]);
+            }
+        }
+        for (; i < size; ++i)
+        {
+            acc[0] = Op::combine(acc[0], data[i]);
+        }
+        return Op::combine(Op::combine(acc[0], acc[1]), Op::combine(acc[2], acc[3]));
+    }
+
+    template<class T>
+    T dotScalar(T const *left, T const *right, size_t size)
+    {
+        T acc[4] = {T(), T(), T(), T()};
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            for (size_t k = 0; k < 4; ++k)
+            {
+                acc[k] += left[i + k] * right[i + k];
+            }
+        }
+        for (; i < size; ++i)
+        {
+            acc[0] += left[i] * right[i];
+        }
+        return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+
+    template<class T>
+    std::pair<T, T> minmaxScalar(T const *data, size_t size)
+    {
+        return {reduceScalar<Min>(data, size, data[0]), reduceScalar<Max>(data, size, data[0])};
+    }
+
+#if FLOW_SIMD_X86
+    inline bool hasAvx2()
+    {
+        static bool const supported = []
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+        }();
+        return supported;
+    }
+
+    /// Lane operations update their first operand in place and take all vectors by reference.
+    /// The generic kernels are compiled without AVX, so passing AVX vectors by value from them
+    /// would disagree with AVX2 lane operations on how the vectors are passed, whenever the calls are not inlined.
+    struct Sse2Float
+    {
+        using Scalar = float;
+        using Vector = __m128;
+        static constexpr size_t lanes = 4;
+
+        static void load(Vector &v, float const *p) { v = _mm_loadu_ps(p); }
+        static void broadcast(Vector &v, float x) { v = _mm_set1_ps(x); }
+        static void store(float *p, Vector const &v) { _mm_storeu_ps(p, v); }
+        static void add(Vector &a, Vector const &b) { a = _mm_add_ps(a, b); }
+        static void mul(Vector &a, Vector const &b) { a = _mm_mul_ps(a, b); }
+        static void min(Vector &a, Vector const &b) { a = _mm_min_ps(a, b); }
+        static void max(Vector &a, Vector const &b) { a = _mm_max_ps(a, b); }
+        static void combine(Add, Vector &a, Vector const &b) { add(a, b); }
+        static void combine(Min, Vector &a, Vector const &b) { min(a, b); }
+        static void combine(Max, Vector &a, Vector const &b) { max(a, b); }
+        static unsigned less(Vector const &a, Vector const &b) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(a, b))); }
+        static unsigned lessEqual(Vector const &a, Vector const &b) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(a, b))); }
+    };
+
+    struct Sse2Double
+    {
+        using Scalar = double;
+        using Vector = __m128d;
+        static constexpr size_t lanes = 2;
+
+        static void load(Vector &v, double const *p) { v = _mm_loadu_pd(p); }
+        static void broadcast(Vector &v, double x) { v = _mm_set1_pd(x); }
+        static void store(double *p, Vector const &v) { _mm_storeu_pd(p, v); }
+        static void add(Vector &a, Vector const &b) { a = _mm_add_pd(a, b); }
+        static void mul(Vector &a, Vector const &b) { a = _mm_mul_pd(a, b); }
+        static void min(Vector &a, Vector const &b) { a = _mm_min_pd(a, b); }
+        static void max(Vector &a, Vector const &b) { a = _mm_max_pd(a, b); }
+        static void combine(Add, Vector &a, Vector const &b) { add(a, b); }
+        static void combine(Min, Vector &a, Vector const &b) { min(a, b); }
+        static void combine(Max, Vector &a, Vector const &b) { max(a, b); }
+        static unsigned less(Vector const &a, Vector const &b) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmplt_pd(a, b))); }
+        static unsigned lessEqual(Vector const &a, Vector const &b) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmple_pd(a, b))); }
+    };
+
+    struct Sse2Int32
+    {
+        using Scalar = int32_t;
+        using Vector = __m128i;
+        static constexpr size_t lanes = 4;
+
+        static void load(Vector &v, int32_t const *p) { v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p)); }
+        static void broadcast(Vector &v, int32_t x) { v = _mm_set1_epi32(x); }
+        static void store(int32_t *p, Vector const &v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+        static void add(Vector &a, Vector const &b) { a = _mm_add_epi32(a, b); }
+
+        // SSE2 lacks 32 bit integer minimum and maximum, so select by a comparison mask.
+        static Vector select(Vector mask, Vector a, Vector b)
+        {
+            return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+        }
+
+        static void min(Vector &a, Vector const &b) { a = select(_mm_cmplt_epi32(a, b), a, b); }
+        static void max(Vector &a, Vector const &b) { a = select(_mm_cmpgt_epi32(a, b), a, b); }
+        static void combine(Add, Vector &a, Vector const &b) { add(a, b); }
+        static void combine(Min, Vector &a, Vector const &b) { min(a, b); }
+        static void combine(Max, Vector &a, Vector const &b) { max(a, b); }
+        static unsigned less(Vector const &a, Vector const &b) { return mask(_mm_cmplt_epi32(a, b)); }
+        static unsigned lessEqual(Vector const &a, Vector const &b) { return mask(_mm_cmpgt_epi32(a, b)) ^ 0xF; }
+        static unsigned mask(Vector m) { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(m))); }
+    };
+
+    /// Permutation indices moving the 32 bit lanes selected by a mask to the front, for each mask.
+    /// Lanes are 32 bit wide, so 64 bit elements select pairs of lanes.
+    template<size_t Lanes>
+    struct CompressIndices
+    {
+        int32_t indices[1 << Lanes][8];
+
+        constexpr CompressIndices(): indices()
+        {
+            constexpr size_t width = 8 / Lanes;
+            for (size_t mask = 0; mask < (1 << Lanes); ++mask)
+            {
+                size_t position = 0;
+                for (size_t lane = 0; lane < Lanes; ++lane)
+                {
+                    if (mask & (1 << lane))
+                    {
+                        for (size_t k = 0; k < width; ++k)
+                        {
+                            indices[mask][position++] = static_cast<int32_t>(lane * width + k);
+                        }
+                    }
+                }
+                // Unselected trailing lanes are don't-cares.
+                for (; position < 8; ++position)
+                {
+                    indices[mask][position] = 0;
+                }
+            }
+        }
+    };
+
+    inline constexpr CompressIndices<8> compressIndices32{};
+    inline constexpr CompressIndices<4> compressIndices64{};
+
+    struct Avx2Float
+    {
+        using Scalar = float;
+        using Vector = __m256;
+        static constexpr size_t lanes = 8;
+
+        FLOW_TARGET_AVX2 static void load(Vector &v, float const *p) { v = _mm256_loadu_ps(p); }
+        FLOW_TARGET_AVX2 static void broadcast(Vector &v, float x) { v = _mm256_set1_ps(x); }
+        FLOW_TARGET_AVX2 static void store(float *p, Vector const &v) { _mm256_storeu_ps(p, v); }
+        FLOW_TARGET_AVX2 static void add(Vector &a, Vector const &b) { a = _mm256_add_ps(a, b); }
+        FLOW_TARGET_AVX2 static void mul(Vector &a, Vector const &b) { a = _mm256_mul_ps(a, b); }
+        FLOW_TARGET_AVX2 static void min(Vector &a, Vector const &b) { a = _mm256_min_ps(a, b); }
+        FLOW_TARGET_AVX2 static void max(Vector &a, Vector const &b) { a = _mm256_max_ps(a, b); }
+        FLOW_TARGET_AVX2 static void combine(Add, Vector &a, Vector const &b) { add(a, b); }
+        FLOW_TARGET_AVX2 static void combine(Min, Vector &a, Vector const &b) { min(a, b); }
+        FLOW_TARGET_AVX2 static void combine(Max, Vector &a, Vector const &b) { max(a, b); }
+        FLOW_TARGET_AVX2 static unsigned less(Vector const &a, Vector const &b) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ))); }
+        FLOW_TARGET_AVX2 static unsigned lessEqual(Vector const &a, Vector const &b) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ))); }
+
+        /// Moves the lanes selected by the mask to the front, keeping their order.
+        FLOW_TARGET_AVX2 static void compress(Vector &v, unsigned mask)
+        {
+            __m256i indices = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(compressIndices32.indices[mask]));
+            v = _mm256_permutevar8x32_ps(v, indices);
+        }
+    };
+
+    struct Avx2Double
+    {
+        using Scalar = double;
+        using Vector = __m256d;
+        static constexpr size_t lanes = 4;
+
+        FLOW_TARGET_AVX2 static void load(Vector &v, double const *p) { v = _mm256_loadu_pd(p); }
+        FLOW_TARGET_AVX2 static void broadcast(Vector &v, double x) { v = _mm256_set1_pd(x); }
+        FLOW_TARGET_AVX2 static void store(double *p, Vector const &v) { _mm256_storeu_pd(p, v); }
+        FLOW_TARGET_AVX2 static void add(Vector &a, Vector const &b) { a = _mm256_add_pd(a, b); }
+        FLOW_TARGET_AVX2 static void mul(Vector &a, Vector const &b) { a = _mm256_mul_pd(a, b); }
+        FLOW_TARGET_AVX2 static void min(Vector &a, Vector const &b) { a = _mm256_min_pd(a, b); }
+        FLOW_TARGET_AVX2 static void max(Vector &a, Vector const &b) { a = _mm256_max_pd(a, b); }
+        FLOW_TARGET_AVX2 static void combine(Add, Vector &a, Vector const &b) { add(a, b); }
+        FLOW_TARGET_AVX2 static void combine(Min, Vector &a, Vector const &b) { min(a, b); }
+        FLOW_TARGET_AVX2 static void combine(Max, Vector &a, Vector const &b) { max(a, b); }
+        FLOW_TARGET_AVX2 static unsigned less(Vector const &a, Vector const &b) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ))); }
+        FLOW_TARGET_AVX2 static unsigned lessEqual(Vector const &a, Vector const &b) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ))); }
+
+        /// Moves the lanes selected by the mask to the front, keeping their order.
+        /// Each double lane is permuted as a pair of 32 bit lanes.
+        FLOW_TARGET_AVX2 static void compress(Vector &v, unsigned mask)
+        {
+            __m256i indices = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(compressIndices64.indices[mask]));
+            v = _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(v), indices));
+        }
+    };
+
+    struct Avx2Int32
+    {
+        using Scalar = int32_t;
+        using Vector = __m256i;
+        static constexpr size_t lanes = 8;
+
+        FLOW_TARGET_AVX2 static void load(Vector &v, int32_t const *p) { v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p)); }
+        FLOW_TARGET_AVX2 static void broadcast(Vector &v, int32_t x) { v = _mm256_set1_epi32(x); }
+        FLOW_TARGET_AVX2 static void store(int32_t *p, Vector const &v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+        FLOW_TARGET_AVX2 static void add(Vector &a, Vector const &b) { a = _mm256_add_epi32(a, b); }
+        FLOW_TARGET_AVX2 static void min(Vector &a, Vector const &b) { a = _mm256_min_epi32(a, b); }
+        FLOW_TARGET_AVX2 static void max(Vector &a, Vector const &b) { a = _mm256_max_epi32(a, b); }
+        FLOW_TARGET_AVX2 static void combine(Add, Vector &a, Vector const &b) { add(a, b); }
+        FLOW_TARGET_AVX2 static void combine(Min, Vector &a, Vector const &b) { min(a, b); }
+        FLOW_TARGET_AVX2 static void combine(Max, Vector &a, Vector const &b) { max(a, b); }
+        FLOW_TARGET_AVX2 static unsigned less(Vector const &a, Vector const &b) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(b, a)))); }
+        FLOW_TARGET_AVX2 static unsigned lessEqual(Vector const &a, Vector const &b) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b)))) ^ 0xFF; }
+
+        /// Moves the lanes selected by the mask to the front, keeping their order.
+        FLOW_TARGET_AVX2 static void compress(Vector &v, unsigned mask)
+        {
+            __m256i indices = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(compressIndices32.indices[mask]));
+            v = _mm256_permutevar8x32_epi32(v, indices);
+        }
+    };
+
+    template<class T>
+    struct Vectorized
+    {
+        static constexpr bool value = false;
+    };
+
+    template<>
+    struct Vectorized<float>
+    {
+        static constexpr bool value = true;
+        using Sse2 = Sse2Float;
+        using Avx2 = Avx2Float;
+    };
+
+    template<>
+    struct Vectorized<double>
+    {
+        static constexpr bool value = true;
+        using Sse2 = Sse2Double;
+        using Avx2 = Avx2Double;
+    };
+
+    template<>
+    struct Vectorized<int32_t>
+    {
+        static constexpr bool value = true;
+        using Sse2 = Sse2Int32;
+        using Avx2 = Avx2Int32;
+    };
+
+    /// Reduces lanes of four vector accumulators, then the accumulator lanes and finally the scalar tail.
+    template<class V, class Op>
+    typename V::Scalar reduceKernel(typename V::Scalar const *data, size_t size, typename V::Scalar identity)
+    {
+        using Scalar = typename V::Scalar;
+        using Vector = typename V::Vector;
+        constexpr size_t lanes = V::lanes;
+
+        Vector acc[4];
+        for (Vector &a: acc)
+        {
+            V::broadcast(a, identity);
+        }
+        size_t i = 0;
+        for (; i + 4 * lanes <= size; i += 4 * lanes)
+        {
+            for (size_t k = 0; k < 4; ++k)
+            {
+                Vector values;
+                V::load(values, data + i + k * lanes);
+                V::combine(Op(), acc[k], values);
+            }
+        }
+        for (; i + lanes <= size; i += lanes)
+        {
+            Vector values;
+            V::load(values, data + i);
+            V::combine(Op(), acc[0], values);
+        }
+
+        V::combine(Op(), acc[0], acc[1]);
+        V::combine(Op(), acc[2], acc[3]);
+        V::combine(Op(), acc[0], acc[2]);
+        Scalar laneValues[lanes];
+        V::store(laneValues, acc[0]);
+
+        Scalar result = identity;
+        for (size_t k = 0; k < lanes; ++k)
+        {
+            result = Op::combine(result, laneValues[k]);
+        }
+        for (; i < size; ++i)
+        {
+            result = Op::combine(result, data[i]);
+        }
+        return result;
+    }
+
+    template<class V>
+    typename V::Scalar dotKernel(typename V::Scalar const *left, typename V::Scalar const *right, size_t size)
+    {
+        using Scalar = typename V::Scalar;
+        using Vector = typename V::Vector;
+        constexpr size_t lanes = V::lanes;
+
+        Vector acc[4];
+        for (Vector &a: acc)
+        {
+            V::broadcast(a, Scalar());
+        }
+        size_t i = 0;
+        for (; i + 4 * lanes <= size; i += 4 * lanes)
+        {
+            for (size_t k = 0; k < 4; ++k)
+            {
+                size_t offset = i + k * lanes;
+                Vector product;
+                Vector factor;
+                V::load(product, left + offset);
+                V::load(factor, right + offset);
+                V::mul(product, factor);
+                V::add(acc[k], product);
+            }
+        }
+        for (; i + lanes <= size; i += lanes)
+        {
+            Vector product;
+            Vector factor;
+            V::load(product, left + i);
+            V::load(factor, right + i);
+            V::mul(product, factor);
+            V::add(acc[0], product);
+        }
+
+        V::add(acc[0], acc[1]);
+        V::add(acc[2], acc[3]);
+        V::add(acc[0], acc[2]);
+        Scalar laneValues[lanes];
+        V::store(laneValues, acc[0]);
+
+        Scalar result = Scalar();
+        for (size_t k = 0; k < lanes; ++k)
+        {
+            result += laneValues[k];
+        }
+        for (; i < size; ++i)
+        {
+            result += left[i] * right[i];
+        }
+        return result;
+    }
+
+    template<class V>
+    std::pair<typename V::Scalar, typename V::Scalar> minmaxKernel(typename V::Scalar const *data, size_t size)
+    {
+        using Scalar = typename V::Scalar;
+        using Vector = typename V::Vector;
+        constexpr size_t lanes = V::lanes;
+
+        Vector minimum;
+        Vector maximum;
+        V::broadcast(minimum, data[0]);
+        V::broadcast(maximum, data[0]);
+        size_t i = 0;
+        for (; i + lanes <= size; i += lanes)
+        {
+            Vector values;
+            V::load(values, data + i);
+            V::min(minimum, values);
+            V::max(maximum, values);
+        }
+
+        Scalar minimumLanes[lanes];
+        Scalar maximumLanes[lanes];
+        V::store(minimumLanes, minimum);
+        V::store(maximumLanes, maximum);
+
+        Scalar resultMinimum = data[0];
+        Scalar resultMaximum = data[0];
+        for (size_t k = 0; k < lanes; ++k)
+        {
+            resultMinimum = Min::combine(resultMinimum, minimumLanes[k]);
+            resultMaximum = Max::combine(resultMaximum, maximumLanes[k]);
+        }
+        for (; i < size; ++i)
+        {
+            resultMinimum = Min::combine(resultMinimum, data[i]);
+            resultMaximum = Max::combine(resultMaximum, data[i]);
+        }
+        return {resultMinimum, resultMaximum};
+    }
+
+    /// Tests a vector of elements against the bounds of the predicate, returning a bit per accepted lane.
+    template<class V, class P>
+    unsigned laneMask(P const &predicate, typename V::Vector const &values)
+    {
+        unsigned mask = (1u << V::lanes) - 1;
+        if constexpr (P::lowerBound != Bound::none)
+        {
+            typename V::Vector lower;
+            V::broadcast(lower, predicate.lowerValue());
+            mask &= P::lowerBound == Bound::open ? V::less(lower, values) : V::lessEqual(lower, values);
+        }
+        if constexpr (P::upperBound != Bound::none)
+        {
+            typename V::Vector upper;
+            V::broadcast(upper, predicate.upperValue());
+            mask &= P::upperBound == Bound::open ? V::less(values, upper) : V::lessEqual(values, upper);
+        }
+        return mask;
+    }
+
+    /// Moves the elements accepted by the predicate to the front of the range, keeping their order.
+    /// Lanes are tested a whole vector at a time, and accepted elements are stored without branching on the result.
+    template<class V, class P>
+    size_t compactKernel(typename V::Scalar *data, size_t size, P const &predicate)
+    {
+        constexpr size_t lanes = V::lanes;
+
+        size_t accepted = 0;
+        size_t i = 0;
+        for (; i + lanes <= size; i += lanes)
+        {
+            typename V::Vector values;
+            V::load(values, data + i);
+            unsigned mask = laneMask<V>(predicate, values);
+            for (size_t k = 0; k < lanes; ++k)
+            {
+                data[accepted] = data[i + k];
+                accepted += (mask >> k) & 1;
+            }
+        }
+        for (; i < size; ++i)
+        {
+            data[accepted] = data[i];
+            accepted += predicate(data[i]) ? 1 : 0;
+        }
+        return accepted;
+    }
+
+    /// Compacts a whole vector at a time by permuting the accepted lanes to the front.
+    /// Storing a full vector at the compacted position never overwrites unread elements,
+    /// because it never lies behind the position the vector was loaded from.
+    template<class V, class P>
+    FLOW_ENTRY_AVX2 size_t compactAvx2(typename V::Scalar *data, size_t size, P const &predicate)
+    {
+        constexpr size_t lanes = V::lanes;
+
+        size_t accepted = 0;
+        size_t i = 0;
+        for (; i + lanes <= size; i += lanes)
+        {
+            typename V::Vector values;
+            V::load(values, data + i);
+            unsigned mask = laneMask<V>(predicate, values);
+            V::compress(values, mask);
+            V::store(data + accepted, values);
+            accepted += static_cast<size_t>(__builtin_popcount(mask));
+        }
+        for (; i < size; ++i)
+        {
+            data[accepted] = data[i];
+            accepted += predicate(data[i]) ? 1 : 0;
+        }
+        return accepted;
+    }
+
+    template<class V, class Op>
+    FLOW_ENTRY_AVX2 typename V::Scalar reduceAvx2(typename V::Scalar const *data, size_t size, typename V::Scalar identity)
+    {
+        return reduceKernel<V, Op>(data, size, identity);
+    }
+
+    template<class V>
+    FLOW_ENTRY_AVX2 typename V::Scalar dotAvx2(typename V::Scalar const *left, typename V::Scalar const *right, size_t size)
+    {
+        return dotKernel<V>(left, right, size);
+    }
+
+    template<class V>
+    FLOW_ENTRY_AVX2 std::pair<typename V::Scalar, typename V::Scalar> minmaxAvx2(typename V::Scalar const *data, size_t size)
+    {
+        return minmaxKernel<V>(data, size);
+    }
+#endif
+
+    /// Reduces the range with the given operation, starting at the identity.
+    /// The result is unspecified if a floating point range contains NaNs and the operation is a minimum or maximum.
+    template<class Op, class T>
+    T reduce(T const *data, size_t size, T identity)
+    {
+#if FLOW_SIMD_X86
+        if constexpr (Vectorized<T>::value)
+        {
+            if (hasAvx2())
+            {
+                return reduceAvx2<typename Vectorized<T>::Avx2, Op>(data, size, identity);
+            }
+            return reduceKernel<typename Vectorized<T>::Sse2, Op>(data, size, identity);
+        }
+#endif
+        return reduceScalar<Op>(data, size, identity);
+    }
+
+    /// The type in which elements of the given type are summed.
+    /// Integers narrower than `int` are promoted as in arithmetic expressions, so that small sums do not wrap around.
+    template<class T>
+    using SumType = std::conditional_t<std::is_arithmetic_v<T>, decltype(T() + T()), T>;
+
+    /// Sums the range.
+    /// Floating point ranges are summed pairwise over blocks, which bounds the rounding error by `O(log n)`
+    /// instead of `O(n)` for a running sum. The block tree only depends on the size of the range.
+    template<class T>
+    SumType<T> sum(T const *data, size_t size)
+    {
+        if constexpr (!std::is_same_v<SumType<T>, T>)
+        {
+            // Promoted elements are summed by a plain loop, which compilers vectorize by widening the elements.
+            SumType<T> total = SumType<T>();
+            for (size_t i = 0; i < size; ++i)
+            {
+                total += data[i];
+            }
+            return total;
+        }
+        else
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                if (size > pairwiseBlockSize)
+                {
+                    size_t half = std::max(pairwiseBlockSize, size / 2 / pairwiseBlockSize * pairwiseBlockSize);
+                    return sum(data, half) + sum(data + half, size - half);
+                }
+            }
+            return reduce<Add>(data, size, T());
+        }
+    }
+
+    /// The range must not be empty.
+    template<class T>
+    T min(T const *data, size_t size)
+    {
+        return reduce<Min>(data, size, data[0]);
+    }
+
+    /// The range must not be empty.
+    template<class T>
+    T max(T const *data, size_t size)
+    {
+        return reduce<Max>(data, size, data[0]);
+    }
+
+    /// The range must not be empty.
+    template<class T>
+    std::pair<T, T> minmax(T const *data, size_t size)
+    {
+#if FLOW_SIMD_X86
+        if constexpr (Vectorized<T>::value)
+        {
+            if (hasAvx2())
+            {
+                return minmaxAvx2<typename Vectorized<T>::Avx2>(data, size);
+            }
+            return minmaxKernel<typename Vectorized<T>::Sse2>(data, size);
+        }
+#endif
+        return minmaxScalar(data, size);
+    }
+
+    /// Computes the dot product, pairwise over blocks for floating point ranges.
+    template<class T>
+    T dot(T const *left, T const *right, size_t size)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (size > pairwiseBlockSize)
+            {
+                size_t half = std::max(pairwiseBlockSize, size / 2 / pairwiseBlockSize * pairwiseBlockSize);
+                return dot(left, right, half) + dot(left + half, right + half, size - half);
+            }
+        }
+#if FLOW_SIMD_X86
+        if constexpr (std::is_floating_point_v<T> && Vectorized<T>::value)
+        {
+            if (hasAvx2())
+            {
+                return dotAvx2<typename Vectorized<T>::Avx2>(left, right, size);
+            }
+            return dotKernel<typename Vectorized<T>::Sse2>(left, right, size);
+        }
+#endif
+        return dotScalar(left, right, size);
+    }
+
+    template<class P, class T, class = void>
+    struct IsVectorizablePredicate: std::false_type
+    {
+    };
+
+    template<class P, class T>
+    struct IsVectorizablePredicate<P, T, std::enable_if_t<P::isVectorizable>>:
+        std::bool_constant<std::is_same_v<typename P::ValueType, T>
+#if FLOW_SIMD_X86
+            && Vectorized<T>::value
+#else
+            && false
+#endif
+        >
+    {
+    };
+
+    /// Whether the predicate can be evaluated on whole vectors of the given element type.
+    template<class P, class T>
+    static constexpr bool isVectorizablePredicate = IsVectorizablePredicate<P, T>::value;
+
+    /// Moves the elements accepted by the vectorizable predicate to the front of the range, keeping their order.
+    /// Returns the number of accepted elements.
+    template<class P, class T>
+    size_t compact(T *data, size_t size, P const &predicate)
+    {
+#if FLOW_SIMD_X86
+        if constexpr (isVectorizablePredicate<P, T>)
+        {
+            if (hasAvx2())
+            {
+                return compactAvx2<typename Vectorized<T>::Avx2>(data, size, predicate);
+            }
+            return compactKernel<typename Vectorized<T>::Sse2>(data, size, predicate);
+        }
+#endif
+        size_t accepted = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            data[accepted] = data[i];
+            accepted += predicate(data[i]) ? 1 : 0;
+        }
+        return accepted;
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+#include <flow/Maybe.h>
+
+namespace flow
+{
+    /// Bounds on the number of elements a sequence will still yield.
+    /// The lower bound is always valid, the upper bound is `None` if the sequence might be unbounded.
+    /// Consumers may use the hint to pre-size buffers, but must not rely on it for correctness.
+    struct SizeHint
+    {
+        size_t lower;
+        Maybe<size_t> upper;
+
+        static SizeHint exactly(size_t size)
+        {
+            return SizeHint{size, size};
+        }
+
+        /// Nothing is known about the sequence's length.
+        static SizeHint unknown()
+        {
+            return SizeHint{0, None()};
+        }
+
+        /// The sequence never stops yielding elements.
+        static SizeHint infinite()
+        {
+            return SizeHint{std::numeric_limits<size_t>::max(), None()};
+        }
+
+        bool isExact() const
+        {
+            return upper.hasValue() && upper.value() == lower;
+        }
+    };
+
+    namespace details
+    {
+        inline size_t saturatingAdd(size_t a, size_t b)
+        {
+            return a > std::numeric_limits<size_t>::max() - b ? std::numeric_limits<size_t>::max() : a + b;
+        }
+
+        /// Returns the upper bound for `min(a, b)`, where `None` denotes unboundedness.
+        inline Maybe<size_t> minUpper(Maybe<size_t> const &a, Maybe<size_t> const &b)
+        {
+            if (!a.hasValue())
+            {
+                return b;
+            }
+            if (!b.hasValue())
+            {
+                return a;
+            }
+            return std::min(a.value(), b.value());
+        }
+
+        template<class S, class = void>
+        struct HasSizeHint: std::false_type
+        {
+        };
+
+        template<class S>
+        struct HasSizeHint<S, std::void_t<decltype(std::declval<S const &>().sizeHint())>>: std::true_type
+        {
+        };
+
+        template<class S>
+        static constexpr bool hasSizeHint = HasSizeHint<S>::value;
+    }
+
+    /// Returns the size hint of the given sequence.
+    /// Sequences which do not implement `sizeHint()` are assumed to yield an unknown number of elements.
+    template<class S>
+    SizeHint sizeHint(S const &sequence)
+    {
+        if constexpr (details::hasSizeHint<S>)
+        {
+            return sequence.sizeHint();
+        }
+        else
+        {
+            return SizeHint::unknown();
+        }
+    }
+}
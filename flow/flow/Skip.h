@@ -0,0 +1,89 @@
+#pragma once
+
+#include <flow/Advance.h>
+#include <flow/Batch.h>
+#include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/TryFold.h>
+
+namespace flow
+{
+    /// Skips the first `n` elements of the base sequence and yields the remaining ones.
+    /// The elements are skipped lazily when the first element is requested,
+    /// without producing them if the base sequence supports advancing.
+    /// Arity: 1 -> 1
+    template<class S>
+    class Skip
+    {
+    public:
+        using ElementType = typename S::ElementType;
+
+        Skip(S &&sequence, size_t const n):
+            sequence(std::move(sequence)),
+            n(n)
+        {
+        }
+
+        Maybe<ElementType> next()
+        {
+            skipPending();
+            return sequence.next();
+        }
+
+        size_t nextBatch(Span<ElementType> batch)
+        {
+            skipPending();
+            return flow::nextBatch(sequence, batch);
+        }
+
+        size_t advanceBy(size_t count)
+        {
+            skipPending();
+            return flow::advanceBy(sequence, count);
+        }
+
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            skipPending();
+            return flow::tryFold(sequence, accumulator, std::forward<F>(function));
+        }
+
+        SizeHint sizeHint() const
+        {
+            SizeHint hint = flow::sizeHint(sequence);
+            if (hint.lower == std::numeric_limits<size_t>::max())
+            {
+                // An infinite sequence stays infinite.
+                return hint;
+            }
+            if (!hint.upper.hasValue())
+            {
+                return SizeHint{hint.lower > n ? hint.lower - n : 0, None()};
+            }
+            size_t upper = hint.upper.value();
+            return SizeHint{hint.lower > n ? hint.lower - n : 0, upper > n ? upper - n : 0};
+        }
+
+    private:
+        void skipPending()
+        {
+            if (n > 0)
+            {
+                flow::advanceBy(sequence, n);
+                n = 0;
+            }
+        }
+
+        S sequence;
+        size_t n;
+    };
+
+    auto skip(size_t const n)
+    {
+        return [=] (auto &&sequence)
+        {
+            return Skip(std::move(sequence), n);
+        };
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <utility>
+
+#include <flow/details.h>
+#include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+
+namespace flow
+{
+    /// Slicing protocol:
+    /// A sliceable sequence implements `S slice(size_t begin, size_t end) const`, which returns an independent
+    /// sequence over the positions `[begin, end)` of the remaining positions, leaving the sliced sequence untouched.
+    /// The number of positions is the upper bound of the sequence's size hint, which must be known.
+    /// For sources, a position is an element.
+    /// Adapters slice their base sequence, so a position of `filter` may yield no element at all.
+    /// Sequences yielding exactly one element per position declare `static constexpr bool isExactlySliceable = true`.
+    /// Slices of a sequence can be iterated concurrently, which is the foundation of the parallel algorithms.
+    ///
+    /// Splitting protocol:
+    /// A sequence may choose where it is divided in halves by implementing `Maybe<std::pair<S, S>> split() const`,
+    /// e.g. `chain` splits at the seam between both of its sequences.
+    /// Adapters implement it by splitting their base sequence, so they keep the split point chosen by their base.
+
+    namespace details
+    {
+        template<class S, class = void>
+        struct IsSliceable: std::false_type
+        {
+        };
+
+        template<class S>
+        struct IsSliceable<S, std::void_t<decltype(std::declval<S const &>().slice(size_t(), size_t()))>>: std::true_type
+        {
+        };
+
+        /// Whether the sequence can be divided into independent slices.
+        template<class S>
+        static constexpr bool isSliceable = IsSliceable<S>::value;
+
+        template<class S, class = void>
+        struct IsExactlySliceable: std::false_type
+        {
+        };
+
+        template<class S>
+        struct IsExactlySliceable<S, std::enable_if_t<S::isExactlySliceable>>: std::true_type
+        {
+        };
+
+        /// Whether the sequence is sliceable and yields exactly one element per position.
+        template<class S>
+        static constexpr bool isExactlySliceable = isSliceable<S> && IsExactlySliceable<S>::value;
+
+        template<class S, class = void>
+        struct HasSplit: std::false_type
+        {
+        };
+
+        template<class S>
+        struct HasSplit<S, std::void_t<decltype(std::declval<S const &>().split())>>: std::true_type
+        {
+        };
+
+        /// Whether the sequence chooses its own split point.
+        template<class S>
+        static constexpr bool hasSplit = HasSplit<S>::value;
+    }
+
+    /// Returns the number of positions the given sliceable sequence can be sliced at.
+    template<class S>
+    size_t slicePositions(S const &sequence)
+    {
+        static_assert(details::isSliceable<S>, "The sequence must be sliceable.");
+        return flow::sizeHint(sequence).upper.value();
+    }
+
+    /// Divides the sliceable sequence into two independent halves, which together yield the remaining elements in order.
+    /// Returns `None` if the sequence cannot be divided, i.e. if it has less than two positions.
+    /// Sequences not implementing `split()` are sliced at the middle position.
+    template<class S>
+    Maybe<std::pair<S, S>> split(S const &sequence)
+    {
+        if constexpr (details::hasSplit<S>)
+        {
+            return sequence.split();
+        }
+        else
+        {
+            size_t positions = slicePositions(sequence);
+            if (positions < 2)
+            {
+                return None();
+            }
+            return std::pair<S, S>(sequence.slice(0, positions / 2), sequence.slice(positions / 2, positions));
+        }
+    }
+
+    namespace details
+    {
+        /// Splits the base sequence of an adapter and wraps both halves by the given function.
+        template<class S, class W>
+        auto splitWrapped(S const &sequence, W wrap) -> Maybe<std::pair<decltype(wrap(std::declval<S>())), decltype(wrap(std::declval<S>()))>>
+        {
+            Maybe<std::pair<S, S>> halves = flow::split(sequence);
+            if (!halves.hasValue())
+            {
+                return None();
+            }
+            using Wrapped = decltype(wrap(std::declval<S>()));
+            return std::pair<Wrapped, Wrapped>(wrap(std::move(halves.value().first)), wrap(std::move(halves.value().second)));
+        }
+    }
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include <flow/Maybe.h>
+#include <flow/Slice.h>
+
+namespace flow
+{
+    /// A random-access iterator over the positions of an exactly sliceable sequence, e.g. `range` or `randomBits`.
+    /// Dereferencing computes the element at the iterator's position by slicing a single position off the sequence,
+    /// so elements are returned by value.
+    template<class S>
+    class SliceIterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<std::remove_reference_t<typename S::ElementType>>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = typename S::ElementType;
+
+        /// Constructs an iterator not pointing into any sequence.
+        SliceIterator():
+            sequence(nullptr),
+            position(0)
+        {
+        }
+
+        SliceIterator(S const *sequence, size_t position):
+            sequence(sequence),
+            position(position)
+        {
+        }
+
+        reference operator*() const
+        {
+            return sequence->slice(position, position + 1).next().value();
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        SliceIterator &operator++()
+        {
+            ++position;
+            return *this;
+        }
+
+        SliceIterator operator++(int)
+        {
+            SliceIterator previous = *this;
+            ++position;
+            return previous;
+        }
+
+        SliceIterator &operator--()
+        {
+            --position;
+            return *this;
+        }
+
+        SliceIterator operator--(int)
+        {
+            SliceIterator previous = *this;
+            --position;
+            return previous;
+        }
+
+        SliceIterator &operator+=(difference_type n)
+        {
+            position = static_cast<size_t>(static_cast<difference_type>(position) + n);
+            return *this;
+        }
+
+        SliceIterator &operator-=(difference_type n)
+        {
+            return *this += -n;
+        }
+
+        friend SliceIterator operator+(SliceIterator iterator, difference_type n)
+        {
+            return iterator += n;
+        }
+
+        friend SliceIterator operator+(difference_type n, SliceIterator iterator)
+        {
+            return iterator += n;
+        }
+
+        friend SliceIterator operator-(SliceIterator iterator, difference_type n)
+        {
+            return iterator -= n;
+        }
+
+        friend difference_type operator-(SliceIterator const &a, SliceIterator const &b)
+        {
+            return static_cast<difference_type>(a.position) - static_cast<difference_type>(b.position);
+        }
+
+        /// Only iterators into the same sequence may be compared.
+        friend bool operator==(SliceIterator const &a, SliceIterator const &b)
+        {
+            return a.position == b.position;
+        }
+
+        friend bool operator!=(SliceIterator const &a, SliceIterator const &b)
+        {
+            return a.position != b.position;
+        }
+
+        friend bool operator<(SliceIterator const &a, SliceIterator const &b)
+        {
+            return a.position < b.position;
+        }
+
+        friend bool operator>(SliceIterator const &a, SliceIterator const &b)
+        {
+            return a.position > b.position;
+        }
+
+        friend bool operator<=(SliceIterator const &a, SliceIterator const &b)
+        {
+            return a.position <= b.position;
+        }
+
+        friend bool operator>=(SliceIterator const &a, SliceIterator const &b)
+        {
+            return a.position >= b.position;
+        }
+
+    private:
+        S const *sequence;
+        size_t position;
+    };
+
+    /// Views the remaining elements of an exactly sliceable sequence through random-access iterators,
+    /// so that standard algorithms, e.g. `std::lower_bound` over a `range`, take their fast paths.
+    /// The view holds a copy of the sequence, which is never iterated itself.
+    /// Its iterators point into the view, so it must outlive them, and they are invalidated when it is moved.
+    template<class S>
+    class SliceView
+    {
+    public:
+        static_assert(details::isExactlySliceable<S>, "Only sequences yielding exactly one element per position can be viewed.");
+
+        using ElementType = typename S::ElementType;
+
+        explicit SliceView(S const &sequence):
+            sequence(sequence),
+            length(slicePositions(sequence))
+        {
+        }
+
+        size_t size() const
+        {
+            return length;
+        }
+
+        bool empty() const
+        {
+            return length == 0;
+        }
+
+        ElementType operator[](size_t index) const
+        {
+            return begin()[static_cast<std::ptrdiff_t>(index)];
+        }
+
+        SliceIterator<S> begin() const
+        {
+            return SliceIterator<S>(&sequence, 0);
+        }
+
+        SliceIterator<S> end() const
+        {
+            return SliceIterator<S>(&sequence, length);
+        }
+
+    private:
+        S sequence;
+        size_t length;
+    };
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+
+namespace flow
+{
+    /// A non-owning view onto a contiguous range of elements.
+    /// Using a span beyond the lifetime of the viewed elements yields dangling pointers.
+    template<class T>
+    class Span
+    {
+    public:
+        using ElementType = T;
+
+        Span(T *data, size_t size):
+            pointer(data),
+            length(size)
+        {
+        }
+
+        template<size_t N>
+        Span(T (&array)[N]):
+            pointer(array),
+            length(N)
+        {
+        }
+
+        T *data() const
+        {
+            return pointer;
+        }
+
+        size_t size() const
+        {
+            return length;
+        }
+
+        bool empty() const
+        {
+            return length == 0;
+        }
+
+        T &operator[](size_t index) const
+        {
+            return pointer[index];
+        }
+
+        T *begin() const
+        {
+            return pointer;
+        }
+
+        T *end() const
+        {
+            return pointer + length;
+        }
+
+        /// Returns the view onto `count` elements, starting at `offset`.
+        Span subspan(size_t offset, size_t count) const
+        {
+            return Span(pointer + offset, count);
+        }
+
+    private:
+        T *pointer;
+        size_t length;
+    };
+}
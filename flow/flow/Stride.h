@@ -1,7 +1,9 @@
 #pragma once
 
+#include <flow/Advance.h>
 #include <flow/Fuse.h>
 #include <flow/Maybe.h>
+#include <flow/SizeHint.h>
 
 namespace flow
 {
@@ -20,14 +22,32 @@ namespace flow
         
         Maybe<ElementType> next()
         {
-            // Skip `n` elements.
+            // Skip `n - 1` elements, without producing them if the base sequence supports it.
             // Because base is fused, it guarantees that consecutive calls to `next()` return `None`.
-            for (size_t k = 0; k < n - 1; ++k) {
-                sequence.next();
-            }
+            flow::advanceBy(sequence, n - 1);
             return sequence.next();
         }
 
+        size_t advanceBy(size_t count)
+        {
+            // Skipping `count` strided elements skips `count * n` base elements.
+            size_t baseCount = count > std::numeric_limits<size_t>::max() / n
+                ? std::numeric_limits<size_t>::max()
+                : count * n;
+            return flow::advanceBy(sequence, baseCount) / n;
+        }
+
+        /// Only every `n`-th element of the base sequence is yielded.
+        SizeHint sizeHint() const
+        {
+            SizeHint hint = flow::sizeHint(sequence);
+            if (!hint.upper.hasValue())
+            {
+                return SizeHint{hint.lower / n, None()};
+            }
+            return SizeHint{hint.lower / n, hint.upper.value() / n};
+        }
+
     private:
         Fuse<S> sequence;
         size_t n;
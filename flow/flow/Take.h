@@ -4,6 +4,12 @@
 
 #pragma once
 
+#include <flow/Advance.h>
+#include <flow/Batch.h>
+#include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/TryFold.h>
+
 namespace flow
 {
     /// Yields up to a fixed amount of elements out of a base sequence.
@@ -47,6 +53,50 @@ namespace flow
             }
         }
 
+        size_t nextBatch(Span<ElementType> batch)
+        {
+            size_t count = flow::nextBatch(sequence, batch.subspan(0, std::min(batch.size(), n - k)));
+            k += count;
+            return count;
+        }
+
+        size_t advanceBy(size_t count)
+        {
+            size_t skipped = flow::advanceBy(sequence, std::min(count, n - k));
+            k += skipped;
+            return skipped;
+        }
+
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            if (k >= n)
+            {
+                return true;
+            }
+
+            // Stopping the base iteration after `n` elements must not be reported as an early stop.
+            bool stopped = false;
+            flow::tryFold(sequence, accumulator, [&] (A &acc, ElementType &&element)
+            {
+                ++k;
+                if (!function(acc, std::forward<ElementType>(element)))
+                {
+                    stopped = true;
+                    return false;
+                }
+                return k < n;
+            });
+            return !stopped;
+        }
+
+        SizeHint sizeHint() const
+        {
+            SizeHint hint = flow::sizeHint(sequence);
+            size_t remaining = n - k;
+            return SizeHint{std::min(hint.lower, remaining), details::minUpper(hint.upper, remaining)};
+        }
+
     private:
         S sequence;
         size_t k;
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace flow
+{
+    /// A fixed set of worker threads executing submitted tasks in submission order.
+    /// Destroying the pool waits for all submitted tasks to finish.
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(size_t threads)
+        {
+            workers.reserve(threads);
+            for (size_t i = 0; i < threads; ++i)
+            {
+                workers.emplace_back([this] { work(); });
+            }
+        }
+
+        ThreadPool(ThreadPool const &) = delete;
+
+        ThreadPool &operator=(ThreadPool const &) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            available.notify_all();
+            for (std::thread &worker: workers)
+            {
+                worker.join();
+            }
+        }
+
+        /// Returns the number of worker threads.
+        size_t size() const
+        {
+            return workers.size();
+        }
+
+        /// Schedules the function on a worker thread.
+        /// Its result, or the exception it throws, is delivered through the returned future.
+        template<class F>
+        auto submit(F function)
+        {
+            using ResultType = std::invoke_result_t<F &>;
+
+            // Tasks are move-only, but the queue requires copyable functions.
+            auto task = std::make_shared<std::packaged_task<ResultType()>>(std::move(function));
+            std::future<ResultType> result = task->get_future();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tasks.emplace_back([task] { (*task)(); });
+            }
+            available.notify_one();
+            return result;
+        }
+
+    private:
+        void work()
+        {
+            for (;;)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    available.wait(lock, [this] { return stopping || !tasks.empty(); });
+                    if (tasks.empty())
+                    {
+                        // Only stop once all pending tasks are done.
+                        return;
+                    }
+                    task = std::move(tasks.front());
+                    tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable available;
+        bool stopping = false;
+    };
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <flow/details.h>
+#include <flow/Maybe.h>
+
+namespace flow
+{
+    namespace details
+    {
+        struct TryFoldProbe
+        {
+            template<class A, class E>
+            bool operator()(A &, E &&) const
+            {
+                return true;
+            }
+        };
+
+        template<class S, class = void>
+        struct HasTryFold: std::false_type
+        {
+        };
+
+        template<class S>
+        struct HasTryFold<S, std::void_t<decltype(std::declval<S &>().tryFold(
+            std::declval<None &>(), std::declval<TryFoldProbe>()))>>: std::true_type
+        {
+        };
+
+        /// Whether the sequence drives the iteration itself, as opposed to being pulled by `next()`.
+        template<class S>
+        static constexpr bool hasTryFold = HasTryFold<S>::value;
+    }
+
+    /// Pushes the elements of the sequence into `function(accumulator, element)`,
+    /// until either the sequence is exhausted or the function returns `false`.
+    /// The accumulator is mutated in place.
+    /// Returns `false` if the function stopped the iteration early, in which case
+    /// the sequence can be continued with the element following the last one passed to the function.
+    /// Sequences which do not implement `tryFold()` are iterated by calling `next()` repeatedly.
+    /// Because sequences implementing it are iterated by a plain loop over their source,
+    /// nested adapters get inlined into a single loop body.
+    template<class S, class A, class F>
+    bool tryFold(S &sequence, A &accumulator, F &&function)
+    {
+        if constexpr (details::hasTryFold<S>)
+        {
+            return sequence.tryFold(accumulator, std::forward<F>(function));
+        }
+        else
+        {
+            for (;;)
+            {
+                Maybe<typename S::ElementType> nextElement = sequence.next();
+                if (!nextElement.hasValue())
+                {
+                    return true;
+                }
+                if (!function(accumulator, std::move(nextElement).value()))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+}
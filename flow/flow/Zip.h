@@ -1,7 +1,12 @@
 #pragma once
 
+#include <flow/Advance.h>
+#include <flow/Batch.h>
 #include <flow/details.h>
 #include <flow/Maybe.h>
+#include <flow/SizeHint.h>
+#include <flow/Slice.h>
+#include <flow/TryFold.h>
 
 namespace flow
 {
@@ -11,6 +16,8 @@ namespace flow
     public:
         using ElementType = std::pair<typename L::ElementType, typename R::ElementType>;
 
+        static constexpr bool isExactlySliceable = details::isExactlySliceable<L> && details::isExactlySliceable<R>;
+
         explicit Zip(L &&left, R &&right):
             left(std::move(left)),
             right(std::move(right))
@@ -25,13 +32,106 @@ namespace flow
                 Maybe<typename R::ElementType> nextRight = right.next();
                 if (nextRight.hasValue())
                 {
-                    return std::pair(nextLeft.value(), nextRight.value());
+                    return ElementType(std::move(nextLeft).value(), std::move(nextRight).value());
                 }
             }
             return None();
         }
 
+        /// Pulls a block from both sequences in lockstep.
+        /// The right block is pulled first, so that only left elements with a right counterpart are pulled.
+        /// Right elements are only discarded if the left sequence runs dry before its size hint's upper bound.
+        template<
+            class A = typename L::ElementType,
+            class B = typename R::ElementType,
+            class = std::enable_if_t<details::isBatchable<A> && details::isBatchable<B>>>
+        size_t nextBatch(Span<ElementType> batch)
+        {
+            A lefts[details::batchSize];
+            B rights[details::batchSize];
+
+            size_t count = flow::nextBatch(right, Span<B>(rights).subspan(0, leftBound(std::min(batch.size(), details::batchSize))));
+
+            // The left sequence may deliver its block in multiple pieces.
+            size_t paired = 0;
+            while (paired < count)
+            {
+                size_t pulled = flow::nextBatch(left, Span<A>(lefts).subspan(paired, count - paired));
+                if (pulled == 0)
+                {
+                    break;
+                }
+                paired += pulled;
+            }
+
+            for (size_t i = 0; i < paired; ++i)
+            {
+                batch[i] = ElementType(std::move(lefts[i]), std::move(rights[i]));
+            }
+            return paired;
+        }
+
+        /// Advances both sequences in lockstep.
+        /// The right sequence is advanced first, and the left sequence only as far as the right one got.
+        size_t advanceBy(size_t n)
+        {
+            return flow::advanceBy(left, flow::advanceBy(right, leftBound(n)));
+        }
+
+        /// Drives the iteration by the left sequence, pulling the right sequence alongside.
+        template<class A, class F>
+        bool tryFold(A &accumulator, F &&function)
+        {
+            using LeftType = typename L::ElementType;
+
+            // The right sequence running dry must not be reported as an early stop.
+            bool stopped = false;
+            flow::tryFold(left, accumulator, [&] (A &acc, LeftType &&leftElement)
+            {
+                Maybe<typename R::ElementType> nextRight = right.next();
+                if (!nextRight.hasValue())
+                {
+                    return false;
+                }
+                if (!function(acc, ElementType(std::forward<LeftType>(leftElement), std::move(nextRight).value())))
+                {
+                    stopped = true;
+                    return false;
+                }
+                return true;
+            });
+            return !stopped;
+        }
+
+        SizeHint sizeHint() const
+        {
+            SizeHint leftHint = flow::sizeHint(left);
+            SizeHint rightHint = flow::sizeHint(right);
+            return SizeHint{
+                std::min(leftHint.lower, rightHint.lower),
+                details::minUpper(leftHint.upper, rightHint.upper)
+            };
+        }
+
+        /// Slices both sequences at the same positions.
+        /// Only available if both sequences yield exactly one element per position, as elements would be paired differently otherwise.
+        template<
+            class A = L,
+            class B = R,
+            class = std::enable_if_t<details::isExactlySliceable<A> && details::isExactlySliceable<B>>>
+        Zip slice(size_t begin, size_t end) const
+        {
+            return Zip(left.slice(begin, end), right.slice(begin, end));
+        }
+
     private:
+        /// Caps the number of elements to pull from the right sequence by the number of elements the left one may still yield.
+        size_t leftBound(size_t n) const
+        {
+            Maybe<size_t> upper = flow::sizeHint(left).upper;
+            return upper.hasValue() ? std::min(n, upper.value()) : n;
+        }
+
         L left;
         R right;
     };
@@ -39,7 +139,8 @@ namespace flow
     template<class S>
     auto zip(S &&right)
     {
-        return [=] (auto &&left) mutable
+        // The right sequence is moved into the constructor instead of being copied, so it may be move-only.
+        return [right = std::forward<S>(right)] (auto &&left) mutable
         {
             return Zip(std::move(left), std::move(right));
         };
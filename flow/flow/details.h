@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <iterator>
 #include <type_traits>
 
 namespace flow::details
@@ -17,4 +18,44 @@ namespace flow::details
         value.~T();
         new (&value) T(std::forward<E>(constructorArgument));
     }
+
+    template<class I, class = void>
+    struct IsRandomAccessIterator: std::false_type
+    {
+    };
+
+    template<class I>
+    struct IsRandomAccessIterator<I, std::void_t<typename std::iterator_traits<I>::iterator_category>>:
+        std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<I>::iterator_category>
+    {
+    };
+
+    /// Whether the distance between two iterators can be computed in constant time.
+    /// Iterators without iterator traits are conservatively treated as not random-access.
+    template<class I>
+    static constexpr bool isRandomAccessIterator = IsRandomAccessIterator<I>::value;
+
+    template<class C, class = void>
+    struct HasData: std::false_type
+    {
+    };
+
+    template<class C>
+    struct HasData<C, std::void_t<decltype(std::declval<C &>().data())>>: std::true_type
+    {
+    };
+
+    template<class S, class = void>
+    struct IsContiguous: std::false_type
+    {
+    };
+
+    template<class S>
+    struct IsContiguous<S, std::enable_if_t<S::isContiguous>>: std::true_type
+    {
+    };
+
+    /// Whether the remaining elements of the sequence are exposed as a raw pointer range through `data()` and `size()`.
+    template<class S>
+    static constexpr bool isContiguous = IsContiguous<S>::value;
 }
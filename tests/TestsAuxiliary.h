@@ -11,6 +11,9 @@ struct Identifier
     bool move_assigned{};
     bool moved_away{};
 
+    /// Counts copy constructions and copy assignments of all identifiers.
+    static inline int copies = 0;
+
     Identifier():
         id(-1),
         default_constructed(true)
@@ -27,6 +30,7 @@ struct Identifier
         id(rhs.id),
         copy_constructed(true)
     {
+        ++copies;
     }
 
     Identifier(Identifier &&rhs) noexcept:
@@ -39,6 +43,7 @@ struct Identifier
     Identifier &operator=(Identifier const &rhs)
     {
         copy_assigned = true;
+        ++copies;
         id = rhs.id;
         return *this;
     }
@@ -3,21 +3,41 @@
 #include <list>
 #include <vector>
 #include <functional>
+#include <iterator>
+#include <numeric>
 #include <map>
 #include <array>
+#include <cmath>
+#include <memory>
+#include <string_view>
 
 #include "flow/Maybe.h"
+#include "flow/Batch.h"
+#include "flow/Buffered.h"
 #include "flow/Elements.h"
+#include "flow/Enumerate.h"
 #include "flow/ElementsReferenced.h"
+#include "flow/ElementsOf.h"
 #include "flow/Flatten.h"
 #include "flow/Filter.h"
+#include "flow/Predicates.h"
 #include "flow/Map.h"
 #include "flow/Zip.h"
 #include "flow/Chain.h"
+#include "flow/Collect.h"
 #include "flow/Take.h"
 #include "flow/Stride.h"
+#include "flow/Skip.h"
+#include "flow/Advance.h"
 #include "flow/Fuse.h"
 #include "flow/Fold.h"
+#include "flow/ParFlatMap.h"
+#include "flow/ParMap.h"
+#include "flow/Parallel.h"
+#include "flow/Random.h"
+#include "flow/Range.h"
+#include "flow/Reductions.h"
+#include "flow/TryFold.h"
 #include "flow/Inspect.h"
 #include "flow/Generate.h"
 #include "flow/Flow.h"
@@ -44,6 +64,35 @@ TEST_CASE("Stream")
     REQUIRE(d.next() == flow::None());
 }
 
+TEST_CASE("Stream construction does not copy stages")
+{
+    std::vector<int> xs = {1, 2, 3, 4};
+    auto offset = [] (Identifier id)
+    {
+        return flow::map2([id = std::move(id)] (int i) { return i + id.id; });
+    };
+
+    Identifier::copies = 0;
+    auto stream = flow::elements2(xs)
+        | offset(Identifier(1))
+        | offset(Identifier(2))
+        | offset(Identifier(3))
+        | offset(Identifier(4))
+        | offset(Identifier(5));
+    REQUIRE(Identifier::copies == 0);
+    REQUIRE(stream.next() == 16);
+
+    // Appending to an lvalue copies each stage exactly once.
+    auto copy = stream | flow::take2(1);
+    REQUIRE(Identifier::copies == 5);
+    REQUIRE(copy.next() == 17);
+
+    auto factor = std::make_unique<int>(3);
+    auto moveOnly = flow::elements2(xs) | flow::map2([factor = std::move(factor)] (int i) { return i * *factor; });
+    REQUIRE(moveOnly.next() == 3);
+    REQUIRE(moveOnly.next() == 6);
+}
+
 TEST_CASE("Maybe: None")
 {
     flow::Maybe<int> a = flow::None();
@@ -102,6 +151,140 @@ TEST_CASE("Maybe: Assignment")
     REQUIRE(b.value() == 5);
 }
 
+TEST_CASE("Maybe: Move assignment")
+{
+    flow::Maybe<Identifier> a = Identifier(1);
+    flow::Maybe<Identifier> b = flow::None();
+
+    b = std::move(a);
+    REQUIRE(b.value().id == 1);
+    REQUIRE(b.value().move_constructed);
+    REQUIRE(a.value().moved_away);
+
+    b = Identifier(2);
+    REQUIRE(b.value().id == 2);
+    REQUIRE(b.value().move_constructed);
+
+    b = flow::None();
+    REQUIRE(!b.hasValue());
+}
+
+TEST_CASE("Maybe: Trivially copyable")
+{
+    static_assert(std::is_trivially_copyable_v<flow::Maybe<int>>);
+    static_assert(std::is_trivially_copyable_v<flow::Maybe<double>>);
+    static_assert(std::is_trivially_copyable_v<flow::Maybe<int &>>);
+    static_assert(std::is_trivially_destructible_v<flow::Maybe<int>>);
+    static_assert(!std::is_trivially_copyable_v<flow::Maybe<Identifier>>);
+    static_assert(!std::is_trivially_destructible_v<flow::Maybe<std::string>>);
+
+    flow::Maybe<int> a = 5;
+    flow::Maybe<int> b = a;
+    b = flow::None();
+    REQUIRE(a.value() == 5);
+    REQUIRE(!b.hasValue());
+}
+
+namespace
+{
+    enum class Color
+    {
+        Red,
+        Green,
+        Invalid,
+    };
+}
+
+template<>
+struct flow::MaybeNiche<Color>: flow::SentinelNiche<Color, Color::Invalid>
+{
+};
+
+template<>
+struct flow::MaybeNiche<float>: flow::NanNiche<float>
+{
+};
+
+template<>
+struct flow::MaybeNiche<uint16_t>: flow::MaxValueNiche<uint16_t>
+{
+};
+
+TEST_CASE("Maybe: Niche")
+{
+    static_assert(sizeof(flow::Maybe<int *>) == sizeof(int *));
+    static_assert(sizeof(flow::Maybe<std::unique_ptr<int>>) == sizeof(int *));
+    static_assert(sizeof(flow::Maybe<std::string_view>) == sizeof(std::string_view));
+    static_assert(sizeof(flow::Maybe<Color>) == sizeof(Color));
+    static_assert(std::is_trivially_copyable_v<flow::Maybe<std::string_view>>);
+
+    // Null pointers and empty views are still values.
+    flow::Maybe<int *> pointer = static_cast<int *>(nullptr);
+    REQUIRE(pointer.hasValue());
+    pointer = flow::None();
+    REQUIRE(!pointer.hasValue());
+
+    flow::Maybe<std::string_view> view = std::string_view();
+    REQUIRE(view.hasValue());
+    REQUIRE(!flow::Maybe<std::string_view>(flow::None()).hasValue());
+
+    flow::Maybe<std::unique_ptr<int>> owner = std::make_unique<int>(5);
+    flow::Maybe<std::unique_ptr<int>> other = flow::None();
+    REQUIRE(!other.hasValue());
+    other = std::move(owner);
+    REQUIRE(*other.value() == 5);
+    REQUIRE(owner.hasValue());
+    REQUIRE(owner.value() == nullptr);
+
+    flow::Maybe<Color> color = Color::Red;
+    REQUIRE(color.value() == Color::Red);
+    color = flow::None();
+    REQUIRE(!color.hasValue());
+
+    // Other NaNs remain values.
+    flow::Maybe<double> nan = std::nan("");
+    REQUIRE(flow::NanNiche<double>::isNone(&nan.value()) == false);
+    double none;
+    flow::NanNiche<double>::setNone(&none);
+    REQUIRE(flow::NanNiche<double>::isNone(&none));
+    REQUIRE(std::isnan(none));
+}
+
+TEST_CASE("Maybe: Opted-in niches")
+{
+    static_assert(sizeof(flow::Maybe<float>) == sizeof(float));
+    static_assert(sizeof(flow::Maybe<uint16_t>) == sizeof(uint16_t));
+
+    flow::Maybe<float> number = 1.5f;
+    REQUIRE(number.hasValue());
+    REQUIRE(number.value() == 1.5f);
+    number = flow::None();
+    REQUIRE(!number.hasValue());
+    number = 2.5f;
+    REQUIRE(number.value() == 2.5f);
+
+    // NaNs produced by arithmetic remain values.
+    number = std::numeric_limits<float>::infinity() - std::numeric_limits<float>::infinity();
+    REQUIRE(number.hasValue());
+    REQUIRE(std::isnan(number.value()));
+    flow::Maybe<float> none = flow::None();
+    REQUIRE(!none.hasValue());
+    number = none;
+    REQUIRE(!number.hasValue());
+
+    flow::Maybe<uint16_t> index = uint16_t(0);
+    REQUIRE(index.hasValue());
+    REQUIRE(index.value() == 0);
+    index = uint16_t(65534);
+    REQUIRE(index.value() == 65534);
+    index = flow::None();
+    REQUIRE(!index.hasValue());
+    flow::Maybe<uint16_t> copy = index;
+    REQUIRE(!copy.hasValue());
+    copy = uint16_t(7);
+    REQUIRE(copy.value() == 7);
+}
+
 TEST_CASE("Take")
 {
     auto a = flow::successors(1) | flow::take(5);
@@ -216,6 +399,39 @@ TEST_CASE("Zip")
     REQUIRE(!c.next().hasValue());
 }
 
+TEST_CASE("Zip batch pulls only paired elements")
+{
+    std::vector<int> xs = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<int> ys = {1, 2, 3};
+    size_t pulledLeft = 0;
+    size_t pulledRight = 0;
+    auto countLeft = [&] (int x) { ++pulledLeft; return x; };
+    auto countRight = [&] (int x) { ++pulledRight; return x; };
+
+    // A longer left sequence is pulled no further than the right one.
+    auto shorterRight = flow::elementsOf(xs) | flow::map(countLeft) | flow::zip(flow::elementsOf(ys) | flow::map(countRight));
+    std::pair<int, int> batch[16];
+    REQUIRE(flow::nextBatch(shorterRight, flow::Span(batch)) == 3);
+    REQUIRE(batch[2] == std::pair(3, 3));
+    REQUIRE(flow::nextBatch(shorterRight, flow::Span(batch)) == 0);
+    REQUIRE(pulledLeft == 3);
+
+    // A longer right sequence is pulled no further than the left one may still yield.
+    pulledLeft = 0;
+    pulledRight = 0;
+    auto shorterLeft = flow::elementsOf(ys) | flow::map(countLeft) | flow::zip(flow::elementsOf(xs) | flow::map(countRight));
+    REQUIRE(flow::nextBatch(shorterLeft, flow::Span(batch)) == 3);
+    REQUIRE(flow::nextBatch(shorterLeft, flow::Span(batch)) == 0);
+    REQUIRE(pulledRight == 3);
+
+    auto skippedLeft = flow::elementsOf(ys) | flow::zip(flow::elementsOf(xs));
+    REQUIRE(flow::advanceBy(skippedLeft, 5) == 3);
+    auto skippedRight = flow::elementsOf(xs) | flow::zip(flow::elementsOf(ys));
+    REQUIRE(flow::advanceBy(skippedRight, 2) == 2);
+    REQUIRE(skippedRight.next().value() == std::pair(3, 3));
+    REQUIRE(flow::advanceBy(skippedRight, 5) == 0);
+}
+
 TEST_CASE("Dereference")
 {
     std::array<int, 4> as{3, 1, 4, 2};
@@ -267,6 +483,29 @@ TEST_CASE("Fold maybe empty")
     REQUIRE(!sum.hasValue());
 }
 
+TEST_CASE("Fold in place")
+{
+    std::vector<int> xs = {3, 1, 3, 2, 3, 1};
+
+    std::map<int, int> histogram;
+    flow::reduceInto(flow::elementsOf(xs), histogram, [] (std::map<int, int> &counts, int x) { ++counts[x]; });
+    REQUIRE(histogram == std::map<int, int>{{1, 2}, {2, 1}, {3, 3}});
+
+    // Mutating functions are detected by fold as well.
+    auto counts = flow::fold(flow::elementsOf(xs), std::map<int, int>(), [] (auto &counts, int x) { ++counts[x]; });
+    REQUIRE(counts == histogram);
+
+    // Functions returning a value through a mutable reference still return the next accumulator.
+    REQUIRE(flow::fold(flow::elementsOf(xs), 0, [] (int &acc, int x) { return acc + x; }) == 13);
+
+    // The accumulator is modified in place instead of being moved into a new one per element.
+    Identifier accumulator(0);
+    flow::reduceInto(flow::elementsOf(xs), accumulator, [] (Identifier &acc, int x) { acc.id += x; });
+    REQUIRE(accumulator.id == 13);
+    REQUIRE(!accumulator.move_assigned);
+    REQUIRE(!accumulator.move_constructed);
+}
+
 TEST_CASE("Generate")
 {
     int n = 4;
@@ -387,3 +626,1097 @@ TEST_CASE("Flatten")
     // There are two inner maps.
     REQUIRE(invocations == 2);
 }
+
+TEST_CASE("Batch")
+{
+    std::vector<int> xs = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    auto flow = flow::elements(xs)
+                | flow::map([] (int i) { return i * 10; })
+                | flow::filter([] (int i) { return i % 20 != 0; })
+                | flow::take(4);
+
+    // Blocks may be delivered partially filled, so gather them until the flow is exhausted.
+    std::vector<int> ys;
+    int batch[3];
+    while (size_t count = flow::nextBatch(flow, flow::Span<int>(batch)))
+    {
+        REQUIRE(count <= 3);
+        ys.insert(ys.end(), batch, batch + count);
+    }
+
+    REQUIRE(ys == std::vector<int>{10, 30, 50, 70});
+    REQUIRE(flow::nextBatch(flow, flow::Span<int>(batch)) == 0);
+}
+
+TEST_CASE("Batch fallback")
+{
+    auto as = {1, 2, 3};
+    auto flow = flow::successors(1)
+                | flow::zip(flow::elements(as))
+                | flow::chain(flow::elements(std::vector<std::pair<int, int>>{{0, 0}}));
+
+    std::pair<int, int> batch[8];
+    REQUIRE(flow::nextBatch(flow, flow::Span(batch)) == 3);
+    REQUIRE(batch[0] == std::pair(1, 1));
+    REQUIRE(batch[2] == std::pair(3, 3));
+    REQUIRE(flow::nextBatch(flow, flow::Span(batch)) == 1);
+    REQUIRE(batch[0] == std::pair(0, 0));
+    REQUIRE(flow::nextBatch(flow, flow::Span(batch)) == 0);
+}
+
+TEST_CASE("Size hint")
+{
+    std::vector<int> xs = {1, 2, 3, 4, 5, 6, 7};
+    std::vector<int> ys = {1, 2, 3};
+
+    auto exact = flow::elements(xs) | flow::map([] (int i) { return i * 2; });
+    REQUIRE(flow::sizeHint(exact).isExact());
+    REQUIRE(flow::sizeHint(exact).lower == 7);
+
+    exact.next();
+    REQUIRE(flow::sizeHint(exact).lower == 6);
+
+    auto filtered = flow::elements(xs) | flow::filter([] (int i) { return i > 3; });
+    REQUIRE(flow::sizeHint(filtered).lower == 0);
+    REQUIRE(flow::sizeHint(filtered).upper.value() == 7);
+
+    auto taken = flow::successors(0) | flow::take(3);
+    REQUIRE(flow::sizeHint(taken).isExact());
+    REQUIRE(flow::sizeHint(taken).lower == 3);
+
+    auto zipped = flow::elements(xs) | flow::zip(flow::elements(ys));
+    REQUIRE(flow::sizeHint(zipped).lower == 3);
+    REQUIRE(flow::sizeHint(zipped).upper.value() == 3);
+
+    auto chained = flow::elements(xs) | flow::chain(flow::elements(ys));
+    REQUIRE(flow::sizeHint(chained).lower == 10);
+    REQUIRE(flow::sizeHint(chained).upper.value() == 10);
+
+    auto strided = flow::elements(xs) | flow::stride(2);
+    REQUIRE(flow::sizeHint(strided).lower == 3);
+    REQUIRE(flow::sizeHint(strided).upper.value() == 3);
+
+    auto cycled = flow::elements(ys) | flow::cycle();
+    REQUIRE(flow::sizeHint(cycled).lower == std::numeric_limits<size_t>::max());
+    REQUIRE(!flow::sizeHint(cycled).upper.hasValue());
+
+    REQUIRE(!flow::sizeHint(flow::successors(0)).upper.hasValue());
+    REQUIRE(!flow::sizeHint(flow::generate([] () -> flow::Maybe<int> { return 1; })).upper.hasValue());
+}
+
+TEST_CASE("Collect")
+{
+    std::vector<int> xs = {1, 2, 3, 4};
+
+    auto ys = flow::collect<std::vector>(flow::elements(xs) | flow::map([] (int i) { return i * i; }));
+    REQUIRE(ys == std::vector<int>{1, 4, 9, 16});
+    REQUIRE(ys.capacity() == 4);
+
+    auto uppercase = [] (char c) { return static_cast<char>(std::toupper(c)); };
+    auto s = flow::collect<std::string>(flow::elements(std::string("hello")) | flow::map(uppercase));
+    REQUIRE(s == "HELLO");
+}
+
+TEST_CASE("Collect moves elements")
+{
+    std::vector<Identifier> xs;
+    xs.emplace_back(1);
+    xs.emplace_back(2);
+
+    auto ys = flow::collect<std::vector>(flow::elements(std::move(xs)));
+
+    REQUIRE(ys.size() == 2);
+    REQUIRE(ys[0].id == 1);
+    REQUIRE(ys[1].id == 2);
+    REQUIRE(ys[0].move_constructed);
+    REQUIRE(ys[1].move_constructed);
+}
+
+TEST_CASE("Collect into")
+{
+    std::vector<int> xs = {1, 2, 3, 4, 5, 6};
+    std::vector<int> buffer;
+
+    flow::collectInto(flow::elements(xs), buffer);
+    REQUIRE(buffer == xs);
+    int const *data = buffer.data();
+
+    // Collecting fewer elements into the same buffer reuses its allocation.
+    flow::collectInto(flow::elements(xs) | flow::filter([] (int i) { return i % 2 == 0; }), buffer);
+    REQUIRE(buffer == std::vector<int>{2, 4, 6});
+    REQUIRE(buffer.data() == data);
+}
+
+TEST_CASE("Stride")
+{
+    std::vector<int> xs = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    auto flow = flow::elements(xs) | flow::stride(3);
+
+    REQUIRE(flow.next().value() == 3);
+    REQUIRE(flow.next().value() == 6);
+    REQUIRE(!flow.next().hasValue());
+    REQUIRE(!flow.next().hasValue());
+}
+
+TEST_CASE("Skip")
+{
+    std::vector<int> xs = {1, 2, 3, 4, 5};
+
+    auto flow = flow::elements(xs) | flow::skip(3);
+
+    REQUIRE(flow::sizeHint(flow).lower == 2);
+    REQUIRE(flow.next().value() == 4);
+    REQUIRE(flow.next().value() == 5);
+    REQUIRE(!flow.next().hasValue());
+}
+
+TEST_CASE("Advance skips mapping")
+{
+    std::vector<int> xs = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    int invocations = 0;
+    auto flow = flow::elements(xs)
+                | flow::map([&] (int i) { ++invocations; return i * 10; })
+                | flow::take(6);
+
+    REQUIRE(flow::nth(flow, 4).value() == 50);
+    REQUIRE(invocations == 1);
+    REQUIRE(flow::advanceBy(flow, 5) == 1);
+    REQUIRE(!flow.next().hasValue());
+    REQUIRE(invocations == 1);
+}
+
+TEST_CASE("Advance fallback")
+{
+    auto flow = flow::successors(0)
+                | flow::filter([] (int i) { return i % 2 == 0; })
+                | flow::chain(flow::elements(std::vector<int>{-1, -2}));
+
+    REQUIRE(flow::nth(flow, 2).value() == 4);
+    auto bounded = std::move(flow) | flow::take(3);
+    REQUIRE(flow::advanceBy(bounded, 10) == 3);
+}
+
+template<class C, class = void>
+struct CanBorrowElements: std::false_type
+{
+};
+
+template<class C>
+struct CanBorrowElements<C, std::void_t<decltype(flow::elementsOf(std::declval<C>()))>>: std::true_type
+{
+};
+
+TEST_CASE("Elements of span")
+{
+    std::vector<int> xs = {1, 2, 3, 4};
+
+    auto flow = flow::elementsOf(xs);
+
+    static_assert(std::is_trivially_copyable_v<decltype(flow)>);
+    static_assert(decltype(flow)::isContiguous);
+
+    REQUIRE(flow.data() == xs.data());
+    REQUIRE(flow.size() == 4);
+    REQUIRE(flow::sizeHint(flow).isExact());
+    REQUIRE(flow.next().value() == 1);
+    REQUIRE(flow.data() == xs.data() + 1);
+    REQUIRE(flow::nth(flow, 1).value() == 3);
+    REQUIRE(flow.size() == 1);
+
+    auto ys = flow::collect<std::vector>(flow::elementsOf(flow::Span<int>(xs.data() + 1, 2)) | flow::map([] (int i) { return i * 2; }));
+    REQUIRE(ys == std::vector<int>{4, 6});
+
+    // Elements of temporary containers would dangle.
+    static_assert(CanBorrowElements<std::vector<int> &>::value);
+    static_assert(CanBorrowElements<std::vector<int> const &>::value);
+    static_assert(!CanBorrowElements<std::vector<int>>::value);
+    static_assert(!CanBorrowElements<std::vector<int> const>::value);
+}
+
+TEST_CASE("Elements of span does not copy")
+{
+    std::array<Identifier, 2> xs = {Identifier(1), Identifier(2)};
+
+    auto flow = flow::elementsOf(xs);
+    auto copy = flow;
+
+    REQUIRE(copy.next().value().id == 1);
+    REQUIRE(flow.next().value().id == 1);
+
+    // The borrowed elements are neither replaced nor moved from.
+    REQUIRE(xs[0].argument_constructed);
+    REQUIRE(!xs[0].moved_away);
+    REQUIRE(&copy.data()[-1] == &xs[0]);
+}
+
+TEST_CASE("Try fold")
+{
+    std::vector<int> xs = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    auto flow = flow::elements(xs)
+                | flow::map([] (int i) { return i * 10; })
+                | flow::filter([] (int i) { return i != 30; });
+
+    // Stop as soon as the sum exceeds 60.
+    int sum = 0;
+    bool exhausted = flow::tryFold(flow, sum, [] (int &sum, int i)
+    {
+        sum += i;
+        return sum <= 60;
+    });
+
+    REQUIRE(!exhausted);
+    REQUIRE(sum == 10 + 20 + 40);
+
+    // The flow continues right after the element which stopped the iteration.
+    REQUIRE(flow.next().value() == 50);
+}
+
+TEST_CASE("Try fold take")
+{
+    auto flow = flow::successors(1)
+                | flow::take(4)
+                | flow::zip(flow::elements(std::vector<int>{1, 1, 1}));
+
+    int sum = 0;
+    REQUIRE(flow::tryFold(flow, sum, [] (int &sum, std::pair<int, int> p)
+    {
+        sum += p.first * p.second;
+        return true;
+    }));
+    REQUIRE(sum == 1 + 2 + 3);
+}
+
+TEST_CASE("For each")
+{
+    std::vector<std::string> strings{"ab", "", "c"};
+
+    std::string s;
+    flow::forEach(flow::elements(strings)
+                  | flow::map([] (std::string const &s) { return flow::elements(s); })
+                  | flow::flatten()
+                  | flow::chain(flow::elements(std::string("de"))), [&] (char c) { s += c; });
+
+    REQUIRE(s == "abcde");
+}
+
+TEST_CASE("Sum")
+{
+    std::vector<int> xs(1000);
+    std::vector<double> ys(1000);
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        xs[i] = static_cast<int>(i);
+        ys[i] = 0.5 * static_cast<double>(i);
+    }
+
+    REQUIRE(flow::sum(flow::elementsOf(xs)) == 999 * 1000 / 2);
+    REQUIRE(flow::sum(flow::elements(ys)) == 0.5 * 999 * 1000 / 2);
+    REQUIRE(flow::sum(flow::elementsOf(xs) | flow::map([] (int i) { return i * 2; })) == 999 * 1000);
+    REQUIRE(flow::sum(flow::elementsOf(xs) | flow::filter([] (int i) { return i < 10; })) == 45);
+    REQUIRE(flow::sum(flow::successors(1) | flow::take(4)) == 10);
+    REQUIRE(flow::sum(flow::elements(std::vector<float>{})) == 0.0f);
+
+    // Narrow integers are summed as int instead of wrapping around.
+    std::vector<uint8_t> bytes(300, 1);
+    static_assert(std::is_same_v<decltype(flow::sum(flow::elementsOf(bytes))), int>);
+    REQUIRE(flow::sum(flow::elementsOf(bytes)) == 300);
+    REQUIRE(flow::sum(flow::elementsOf(bytes) | flow::map([] (uint8_t b) { return static_cast<uint8_t>(b * 200); })) == 60000);
+    REQUIRE(flow::sum(flow::elementsReferenced(bytes)) == 300);
+    std::vector<bool> flags{true, false, true};
+    REQUIRE(flow::sum(flow::elements(flags)) == 2);
+}
+
+TEST_CASE("Sum pairwise")
+{
+    // A running float sum of ten million tenths is off by far more than the pairwise sum.
+    std::vector<float> xs(10000000, 0.1f);
+
+    REQUIRE(std::abs(flow::sum(flow::elementsOf(xs)) - 1e6f) < 1.0f);
+    REQUIRE(std::abs(flow::sum(flow::elementsOf(xs) | flow::map([] (float x) { return x; })) - 1e6f) < 1.0f);
+}
+
+TEST_CASE("Min max")
+{
+    std::vector<int> xs = {5, -3, 12, 7, 0, 11, 4, 9, 3, -1, 8, 2, 6};
+    std::vector<double> ys = {2.5, -1.5, 7.25};
+
+    REQUIRE(flow::min(flow::elementsOf(xs)).value() == -3);
+    REQUIRE(flow::max(flow::elementsOf(xs)).value() == 12);
+    REQUIRE(flow::minmax(flow::elementsOf(xs)).value() == std::pair(-3, 12));
+    REQUIRE(flow::minmax(flow::elements(ys)).value() == std::pair(-1.5, 7.25));
+    REQUIRE(flow::max(flow::elementsOf(xs) | flow::map([] (int i) { return -i; })).value() == 3);
+    REQUIRE(flow::minmax(flow::successors(3) | flow::take(3)).value() == std::pair(3, 5));
+    std::vector<int> empty;
+    REQUIRE(!flow::min(flow::elementsOf(empty)).hasValue());
+    REQUIRE(!flow::minmax(flow::successors(0) | flow::take(0)).hasValue());
+}
+
+TEST_CASE("Dot")
+{
+    std::vector<double> xs = {1, 2, 3, 4, 5};
+    std::vector<double> ys = {2, 2, 2, 2, 2, 2};
+
+    REQUIRE(flow::dot(flow::elementsOf(xs), flow::elementsOf(ys)) == 30.0);
+    REQUIRE(flow::dot(flow::elements(xs) | flow::take(2), flow::elementsOf(ys)) == 6.0);
+}
+
+TEST_CASE("Vectorized filter")
+{
+    std::vector<int> xs(1000);
+    std::vector<float> ys(1000);
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        xs[i] = static_cast<int>((i * 7919) % 1000);
+        ys[i] = static_cast<float>(xs[i]) - 500.0f;
+    }
+
+    auto expected = [] (auto const &xs, auto predicate)
+    {
+        std::remove_const_t<std::remove_reference_t<decltype(xs)>> result;
+        std::copy_if(xs.begin(), xs.end(), std::back_inserter(result), predicate);
+        return result;
+    };
+
+    REQUIRE(flow::collect<std::vector>(flow::elementsOf(xs) | flow::filter(flow::lessThan(500))) == expected(xs, flow::lessThan(500)));
+    REQUIRE(flow::collect<std::vector>(flow::elementsOf(xs) | flow::filter(flow::between(100, 199))) == expected(xs, flow::between(100, 199)));
+    REQUIRE(flow::collect<std::vector>(flow::elementsOf(ys) | flow::filter(flow::greaterEqual(0.0f))) == expected(ys, flow::greaterEqual(0.0f)));
+    REQUIRE(flow::sum(flow::elementsOf(xs) | flow::filter(flow::equalTo(7))) == 7);
+
+    // Predicates also apply to elements of other types, element by element.
+    REQUIRE(flow::collect<std::vector>(flow::elements(std::vector<double>{1.5, 2.5, 3.5}) | flow::filter(flow::greaterThan(2))) == std::vector<double>{2.5, 3.5});
+}
+
+TEST_CASE("Parallel reduce")
+{
+    std::vector<long> xs(10000);
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        xs[i] = static_cast<long>(i);
+    }
+
+    auto plus = [] (long a, long b) { return a + b; };
+    flow::ParallelOptions options{4, 100};
+
+    REQUIRE(flow::parallelFold(flow::elementsOf(xs), 0L, plus, options) == 49995000);
+    REQUIRE(flow::parallelFold(flow::elements(xs) | flow::map([] (long x) { return 2 * x; }), 0L, plus, options) == 99990000);
+    REQUIRE(flow::parallelFold(flow::elementsOf(xs) | flow::filter([] (long x) { return x % 2 == 0; }), 0L, plus, options) == 24995000);
+    std::vector<long> empty;
+    REQUIRE(flow::parallelFold(flow::elementsOf(empty), 7L, plus, options) == 7);
+
+    // Elements are folded and chunk results combined by different functions.
+    auto count = flow::parallelReduce(flow::elementsOf(xs), size_t(0),
+        [] (size_t acc, long) { return acc + 1; },
+        [] (size_t a, size_t b) { return a + b; },
+        options);
+    REQUIRE(count == xs.size());
+
+    // Zipped sequences are sliced in lockstep.
+    auto zipped = flow::elementsOf(xs) | flow::zip(flow::elementsOf(xs) | flow::map([] (long x) { return x * x; }));
+    REQUIRE(flow::parallelReduce(zipped, 0L,
+        [] (long acc, std::pair<long, long> const &pair) { return acc + pair.second - pair.first * pair.first; },
+        plus, options) == 0);
+
+    // Reductions may be nested, and exceptions reach the calling thread.
+    auto nested = flow::parallelReduce(flow::elementsOf(xs), 0L,
+        [&] (long acc, long x) { return x % 1000 == 0 ? acc + flow::parallelFold(flow::elementsOf(xs), 0L, plus, options) : acc; },
+        plus, options);
+    REQUIRE(nested == 10 * 49995000L);
+    REQUIRE_THROWS_AS(flow::parallelFold(flow::elementsOf(xs), 0L, [] (long acc, long x) -> long
+    {
+        if (x == 5000)
+        {
+            throw std::runtime_error("Five thousand");
+        }
+        return acc + x;
+    }, options), std::runtime_error);
+}
+
+TEST_CASE("Parallel reduce is deterministic")
+{
+    std::vector<float> xs(100000);
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        xs[i] = 1.0f / static_cast<float>(i + 1);
+    }
+
+    auto plus = [] (float a, float b) { return a + b; };
+    flow::ParallelOptions options{8, 1000};
+    float first = flow::parallelFold(flow::elementsOf(xs), 0.0f, plus, options);
+    for (size_t run = 0; run < 10; ++run)
+    {
+        REQUIRE(flow::parallelFold(flow::elementsOf(xs), 0.0f, plus, options) == first);
+    }
+
+    // A single thread reduces the same chunks in the same order.
+    REQUIRE(flow::parallelFold(flow::elementsOf(xs), 0.0f, plus, flow::ParallelOptions{1, 1000}) == first);
+}
+
+TEST_CASE("Parallel sum is reproducible")
+{
+    std::vector<double> xs;
+    for (int i = 0; i < 100000; ++i)
+    {
+        xs.push_back(std::sin(i) * 1e6 + 1.0 / (i + 1));
+    }
+
+    double expected = flow::parallelSum(flow::elementsOf(xs), 1);
+    for (size_t threads: {2, 3, 8})
+    {
+        REQUIRE(flow::parallelSum(flow::elementsOf(xs), threads) == expected);
+    }
+    REQUIRE(flow::parallelSum(flow::elements(xs), 4) == expected);
+    REQUIRE(std::abs(expected - flow::sum(flow::elementsOf(xs))) < 1e-6);
+
+    auto squares = flow::elementsOf(xs) | flow::map([] (double x) { return x * x; });
+    REQUIRE(flow::parallelSum(squares, 4) == flow::parallelSum(squares, 1));
+
+    std::vector<int> empty;
+    REQUIRE(flow::parallelSum(flow::elementsOf(empty), 2) == 0);
+
+    std::vector<int8_t> bytes(100000, 1);
+    REQUIRE(flow::parallelSum(flow::elementsOf(bytes), 3) == 100000);
+}
+
+TEST_CASE("Split")
+{
+    std::vector<int> xs{1, 2, 3, 4, 5};
+
+    auto halves = flow::split(flow::elementsOf(xs) | flow::map([] (int x) { return x * 10; }));
+    REQUIRE(halves.hasValue());
+    REQUIRE(flow::collect<std::vector>(halves.value().first) == std::vector<int>{10, 20});
+    REQUIRE(flow::collect<std::vector>(halves.value().second) == std::vector<int>{30, 40, 50});
+
+    auto filtered = flow::split(flow::elements(xs) | flow::filter([] (int x) { return x % 2 == 1; }));
+    REQUIRE(flow::collect<std::vector>(filtered.value().first) == std::vector<int>{1});
+    REQUIRE(flow::collect<std::vector>(filtered.value().second) == std::vector<int>{3, 5});
+
+    // Indices continue across the halves.
+    auto enumerated = flow::split(flow::elementsOf(xs) | flow::enumerate());
+    REQUIRE(flow::collect<std::vector>(enumerated.value().second) == std::vector<std::tuple<size_t, int>>{{2, 3}, {3, 4}, {4, 5}});
+
+    auto zipped = flow::split(flow::elementsOf(xs) | flow::zip(flow::elements(std::vector<char>{'a', 'b', 'c', 'd'})));
+    REQUIRE(flow::collect<std::vector>(zipped.value().first) == std::vector<std::pair<int, char>>{{1, 'a'}, {2, 'b'}});
+    REQUIRE(flow::collect<std::vector>(zipped.value().second) == std::vector<std::pair<int, char>>{{3, 'c'}, {4, 'd'}});
+
+    // Chains are split at the seam, even through adapters.
+    std::vector<int> ys{6};
+    auto chained = flow::split(flow::elementsOf(xs) | flow::chain(flow::elementsOf(ys)) | flow::map([] (int x) { return -x; }));
+    REQUIRE(flow::collect<std::vector>(chained.value().first) == std::vector<int>{-1, -2, -3, -4, -5});
+    REQUIRE(flow::collect<std::vector>(chained.value().second) == std::vector<int>{-6});
+
+    // The halves of a chain slice can be split again.
+    auto quarters = flow::split(chained.value().first);
+    REQUIRE(flow::collect<std::vector>(quarters.value().second) == std::vector<int>{-3, -4, -5});
+
+    REQUIRE(!flow::split(flow::elementsOf(ys)).hasValue());
+
+    // Split sequences can be reduced in parallel.
+    REQUIRE(flow::parallelReduce(flow::elementsOf(xs) | flow::chain(flow::elementsOf(ys)) | flow::enumerate(), size_t(0),
+        [] (size_t acc, std::tuple<size_t, int> const &element) { return acc + std::get<0>(element) * std::get<1>(element); },
+        [] (size_t a, size_t b) { return a + b; },
+        flow::ParallelOptions{3, 2}) == 70);
+}
+
+TEST_CASE("Parallel map")
+{
+    std::vector<int> xs(1000);
+    for (size_t i = 0; i < xs.size(); ++i)
+    {
+        xs[i] = static_cast<int>(i);
+    }
+
+    auto square = [] (int x) { return std::to_string(x * x); };
+    std::vector<std::string> expected = flow::collect<std::vector>(flow::elementsOf(xs) | flow::map(square));
+
+    REQUIRE(flow::collect<std::vector>(flow::elementsOf(xs) | flow::parMap(square, 4, 16)) == expected);
+
+    auto unordered = flow::collect<std::vector>(flow::elementsOf(xs) | flow::parMapUnordered(square, 4, 16));
+    std::sort(unordered.begin(), unordered.end());
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(unordered == expected);
+
+    // No more than a window of elements is pulled ahead.
+    size_t pulled = 0;
+    size_t yielded = 0;
+    auto mapped = flow::elementsOf(xs)
+        | flow::inspect([&] (int) { ++pulled; })
+        | flow::parMap([] (int x) { return x + 1; }, 3, 8);
+    for (flow::Maybe<int> x = mapped.next(); x.hasValue(); x = mapped.next())
+    {
+        ++yielded;
+        REQUIRE(x.value() == static_cast<int>(yielded));
+        REQUIRE(pulled - yielded < 8);
+    }
+    REQUIRE(yielded == xs.size());
+}
+
+TEST_CASE("Parallel map rethrows")
+{
+    std::vector<int> xs{1, 2, 3, 4};
+    auto failing = flow::elementsOf(xs) | flow::parMap([] (int x)
+    {
+        if (x == 3)
+        {
+            throw std::runtime_error("three");
+        }
+        return x;
+    }, 2, 4);
+
+    REQUIRE(failing.next() == flow::Maybe<int>(1));
+    REQUIRE(failing.next() == flow::Maybe<int>(2));
+    REQUIRE_THROWS_AS(failing.next(), std::runtime_error);
+    REQUIRE(failing.next() == flow::Maybe<int>(4));
+    REQUIRE(!failing.next().hasValue());
+
+    // Dropping a partially consumed stage waits for the elements in flight.
+    auto dropped = flow::elementsOf(xs) | flow::parMap([] (int x) { return x; }, 2, 4);
+    REQUIRE(dropped.next() == flow::Maybe<int>(1));
+}
+
+TEST_CASE("Parallel flat map")
+{
+    std::vector<std::vector<int>> rows;
+    for (int i = 0; i < 200; ++i)
+    {
+        rows.push_back(std::vector<int>(i % 7, i));
+    }
+
+    std::vector<int> expected;
+    for (std::vector<int> const &row: rows)
+    {
+        expected.insert(expected.end(), row.begin(), row.end());
+    }
+
+    auto rowElements = [] (std::vector<int> const &row) { return flow::elementsOf(row); };
+    REQUIRE(flow::collect<std::vector>(flow::elementsOf(rows) | flow::parFlatMap(rowElements, 4, 8)) == expected);
+
+    std::vector<int> unordered = flow::collect<std::vector>(flow::elementsOf(rows) | flow::parFlatMapUnordered(rowElements, 4));
+    std::sort(unordered.begin(), unordered.end());
+    REQUIRE(unordered == expected);
+
+    auto subSequences = flow::elementsOf(rows) | flow::map([] (std::vector<int> row) { return flow::elements(std::move(row)); });
+    REQUIRE(flow::sum(std::move(subSequences) | flow::parFlatten(3)) == flow::sum(flow::elementsOf(expected)));
+
+    // Move-only functions are moved into the stage.
+    std::vector<int> counts{1, 2};
+    auto factor = std::make_unique<int>(2);
+    auto scaled = flow::elementsOf(counts)
+        | flow::parFlatMap([factor = std::move(factor)] (int x) { return flow::range(0, x * *factor); }, 2);
+    REQUIRE(flow::collect<std::vector>(std::move(scaled)) == std::vector<int>{0, 1, 0, 1, 2, 3});
+
+    std::vector<int> xs{1, 2, 3};
+    auto failing = flow::elementsOf(xs) | flow::parFlatMap([] (int x)
+    {
+        if (x == 2)
+        {
+            throw std::runtime_error("two");
+        }
+        return flow::range(0, x);
+    }, 2);
+    REQUIRE(failing.next() == flow::Maybe<int>(0));
+    REQUIRE_THROWS_AS(failing.next(), std::runtime_error);
+    REQUIRE(failing.next() == flow::Maybe<int>(0));
+    REQUIRE(failing.next() == flow::Maybe<int>(1));
+    REQUIRE(failing.next() == flow::Maybe<int>(2));
+    REQUIRE(!failing.next().hasValue());
+}
+
+TEST_CASE("Buffered")
+{
+    std::thread::id producer;
+    size_t i = 0;
+    auto produced = flow::generate([&] () -> flow::Maybe<size_t>
+    {
+        producer = std::this_thread::get_id();
+        if (i == 1000)
+        {
+            return flow::None();
+        }
+        return i++;
+    });
+
+    std::vector<size_t> expected(1000);
+    for (size_t k = 0; k < expected.size(); ++k)
+    {
+        expected[k] = k;
+    }
+    REQUIRE(flow::collect<std::vector>(std::move(produced) | flow::buffered(16)) == expected);
+    REQUIRE(producer != std::this_thread::get_id());
+    REQUIRE(flow::collect<std::vector>(flow::elements(expected) | flow::buffered<flow::SpinningWait>(1)) == expected);
+
+    // Dropping the buffered flow stops an infinite producer.
+    {
+        auto infinite = flow::successors(0) | flow::buffered(4);
+        REQUIRE(infinite.next() == flow::Maybe<int>(0));
+        REQUIRE(infinite.next() == flow::Maybe<int>(1));
+    }
+    {
+        auto infinite = flow::successors(0) | flow::buffered<flow::SpinningWait>(4);
+        REQUIRE(infinite.next() == flow::Maybe<int>(0));
+    }
+}
+
+TEST_CASE("Buffered rethrows")
+{
+    int i = 0;
+    auto failing = flow::generate([&] () -> flow::Maybe<int>
+    {
+        if (i == 2)
+        {
+            throw std::runtime_error("exhausted");
+        }
+        return i++;
+    }) | flow::buffered(8);
+
+    REQUIRE(failing.next() == flow::Maybe<int>(0));
+    REQUIRE(failing.next() == flow::Maybe<int>(1));
+    REQUIRE_THROWS_AS(failing.next(), std::runtime_error);
+}
+
+TEST_CASE("Flatten in blocks")
+{
+    std::vector<std::vector<int>> rows = {{1, 2, 3}, {}, {4}, {}, {}, {5, 6, 7, 8}};
+
+    auto flattened = flow::elements(rows)
+        | flow::map([] (std::vector<int> row) { return flow::elements(std::move(row)); })
+        | flow::flatten();
+    int batch[5];
+    REQUIRE(flattened.nextBatch(flow::Span<int>(batch)) == 5);
+    REQUIRE(std::vector<int>(batch, batch + 5) == std::vector<int>{1, 2, 3, 4, 5});
+    REQUIRE(flattened.nextBatch(flow::Span<int>(batch)) == 3);
+    REQUIRE(flattened.nextBatch(flow::Span<int>(batch)) == 0);
+
+    // Inner vectors are borrowed instead of copied.
+    auto borrowed = flow::elementsReferenced(rows) | flow::flatMap([] (std::vector<int> &row) { return flow::elementsOf(row); });
+    REQUIRE(flow::sum(borrowed) == 36);
+
+    std::vector<std::vector<Identifier>> table(3);
+    table[0].emplace_back(1);
+    table[0].emplace_back(2);
+    table[2].emplace_back(3);
+    Identifier::copies = 0;
+    auto referenced = flow::elementsReferenced(table)
+        | flow::flatMap([] (std::vector<Identifier> &row) { return flow::elementsReferenced(row); })
+        | flow::map([] (Identifier &id) { return id.id; });
+    REQUIRE(flow::sum(referenced) == 6);
+    REQUIRE(Identifier::copies == 0);
+
+    std::vector<std::vector<Identifier>> groups(3);
+    groups[0].emplace_back(1);
+    groups[2].emplace_back(2);
+    groups[2].emplace_back(3);
+    Identifier::copies = 0;
+    auto ids = flow::elements(std::move(groups))
+        | flow::flatMap([] (std::vector<Identifier> &group) { return flow::elementsReferenced(group); })
+        | flow::map([] (Identifier &id) { return id.id; });
+    REQUIRE(ids.next().value() == 1);
+
+    // Copies continue at the same position.
+    auto copy = ids;
+    REQUIRE(copy.next().value() == 2);
+    REQUIRE(ids.next().value() == 2);
+    REQUIRE(flow::collect<std::vector>(std::move(ids)) == std::vector<int>{3});
+    REQUIRE(Identifier::copies == 3);
+}
+
+TEST_CASE("Flatten moves sub sequences")
+{
+    auto identifiers = [] (int n)
+    {
+        std::vector<Identifier> ids;
+        ids.reserve(2);
+        ids.emplace_back(2 * n);
+        ids.emplace_back(2 * n + 1);
+        return flow::elements(std::move(ids));
+    };
+
+    auto flattened = flow::successors(0) | flow::take(3) | flow::map(identifiers) | flow::flatten();
+    for (int id = 0; id < 6; ++id)
+    {
+        Identifier element = flattened.next().value();
+        REQUIRE(element.id == id);
+        REQUIRE(!element.copy_constructed);
+    }
+    REQUIRE(!flattened.next().hasValue());
+
+    auto collected = flow::collect<std::vector>(flow::successors(0) | flow::take(3) | flow::map(identifiers) | flow::flatten());
+    REQUIRE(collected.size() == 6);
+    for (Identifier const &element: collected)
+    {
+        REQUIRE(!element.copy_constructed);
+    }
+}
+
+TEST_CASE("Move-only elements")
+{
+    auto pointers = [] (std::initializer_list<int> values)
+    {
+        std::vector<std::unique_ptr<int>> result;
+        for (int value: values)
+        {
+            result.push_back(std::make_unique<int>(value));
+        }
+        return flow::elements(std::move(result));
+    };
+    auto dereferenced = [] (std::vector<std::unique_ptr<int>> const &pointers)
+    {
+        std::vector<int> result;
+        for (auto const &pointer: pointers)
+        {
+            result.push_back(*pointer);
+        }
+        return result;
+    };
+
+    auto pipeline = pointers({1, 2, 3, 4, 5, 6})
+        | flow::map([] (std::unique_ptr<int> pointer) { *pointer *= 10; return pointer; })
+        | flow::filter([] (std::unique_ptr<int> const &pointer) { return *pointer != 30; })
+        | flow::inspect([] (std::unique_ptr<int> const &pointer) { REQUIRE(pointer != nullptr); })
+        | flow::chain(pointers({7}))
+        | flow::skip(1)
+        | flow::take(4)
+        | flow::fuse();
+    REQUIRE(dereferenced(flow::collect<std::vector>(std::move(pipeline))) == std::vector<int>{20, 40, 50, 60});
+
+    auto zipped = pointers({1, 2}) | flow::zip(pointers({3, 4})) | flow::enumerate();
+    auto element = zipped.next().value();
+    REQUIRE(std::get<0>(element) == 0);
+    REQUIRE(*std::get<1>(element).first == 1);
+    REQUIRE(*std::get<1>(element).second == 3);
+
+    auto flattened = flow::successors(0) | flow::take(2)
+        | flow::map([=] (int i) { return pointers({i, i}); })
+        | flow::flatten();
+    REQUIRE(dereferenced(flow::collect<std::vector>(std::move(flattened))) == std::vector<int>{0, 0, 1, 1});
+
+    std::unique_ptr<int> pointer = std::make_unique<int>(5);
+    flow::Maybe<std::unique_ptr<int> &&> reference = std::move(pointer);
+    std::unique_ptr<int> moved = reference.value();
+    REQUIRE(*moved == 5);
+    REQUIRE(pointer == nullptr);
+}
+
+TEST_CASE("Stages do not copy elements")
+{
+    auto identifiers = [] (int n)
+    {
+        std::vector<Identifier> ids;
+        ids.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            ids.emplace_back(i);
+        }
+        return flow::elements(std::move(ids));
+    };
+    auto identity = [] (Identifier id) { return id; };
+    auto even = [] (Identifier const &id) { return id.id % 2 == 0; };
+
+    Identifier::copies = 0;
+    auto check = [] (auto &&flow, size_t count)
+    {
+        size_t pulled = 0;
+        while (flow.next().hasValue())
+        {
+            ++pulled;
+        }
+        REQUIRE(pulled == count);
+        REQUIRE(Identifier::copies == 0);
+    };
+
+    check(identifiers(8), 8);
+    check(identifiers(8) | flow::map(identity), 8);
+    check(identifiers(8) | flow::filter(even), 4);
+    check(identifiers(8) | flow::inspect([] (Identifier const &) {}), 8);
+    check(identifiers(8) | flow::zip(identifiers(6)), 6);
+    check(identifiers(8) | flow::chain(identifiers(2)), 10);
+    check(identifiers(8) | flow::take(3), 3);
+    check(identifiers(8) | flow::skip(3), 5);
+    check(identifiers(8) | flow::stride(2), 4);
+    check(identifiers(8) | flow::fuse(), 8);
+    check(identifiers(8) | flow::enumerate(), 8);
+    check(flow::successors(1) | flow::take(3) | flow::map(identifiers) | flow::flatten(), 6);
+
+    REQUIRE(flow::collect<std::vector>(identifiers(8) | flow::map(identity) | flow::filter(even)).size() == 4);
+    REQUIRE(flow::fold(identifiers(8) | flow::zip(identifiers(8)), 0, [] (int acc, std::pair<Identifier, Identifier> const &pair)
+    {
+        return acc + pair.first.id + pair.second.id;
+    }) == 56);
+    REQUIRE(Identifier::copies == 0);
+}
+
+namespace
+{
+    struct Person
+    {
+        std::string name;
+        int age;
+
+        bool isAdult() const
+        {
+            return age >= 18;
+        }
+    };
+}
+
+TEST_CASE("Map projections")
+{
+    std::vector<Person> people{{"Ada", 36}, {"Tim", 12}, {"Eve", 29}};
+
+    // Referenced elements are projected onto references of their members.
+    auto names = flow::elementsReferenced(people)
+        | flow::filter([] (Person const &person) { return person.isAdult(); })
+        | flow::map(&Person::name);
+    static_assert(std::is_same_v<decltype(names)::ElementType, std::string &>);
+    REQUIRE(&names.next().value() == &people[0].name);
+    REQUIRE(&names.next().value() == &people[2].name);
+    REQUIRE(!names.next().hasValue());
+
+    auto references = flow::elementsReferenced(people)
+        | flow::map([] (Person const &person) -> std::string const & { return person.name; });
+    REQUIRE(&references.next().value() == &people[0].name);
+
+    // Member functions are called.
+    REQUIRE(flow::collect<std::vector>(flow::elementsReferenced(people) | flow::map(&Person::isAdult)) == std::vector<bool>{true, false, true});
+
+    // Owned elements are projected onto owned members, which are moved out.
+    auto owned = flow::elements(people) | flow::map(&Person::name);
+    static_assert(std::is_same_v<decltype(owned)::ElementType, std::string>);
+    REQUIRE(flow::collect<std::vector>(std::move(owned)) == std::vector<std::string>{"Ada", "Tim", "Eve"});
+    REQUIRE(people[0].name == "Ada");
+
+    // References into owned elements are copied before the element is destroyed.
+    auto copies = flow::elements(people)
+        | flow::map([] (Person const &person) -> std::string const & { return person.name; });
+    static_assert(std::is_same_v<decltype(copies)::ElementType, std::string>);
+    REQUIRE(copies.next().value() == "Ada");
+    REQUIRE(copies.next().value().c_str() == std::string("Tim"));
+}
+
+TEST_CASE("Parallel map functions")
+{
+    std::vector<Person> people{{"Ada", 36}, {"Tim", 12}, {"Eve", 29}};
+
+    // Member pointers project owned copies of the elements.
+    auto names = flow::elementsReferenced(people) | flow::parMap(&Person::name, 2, 2);
+    static_assert(std::is_same_v<decltype(names)::ElementType, std::string>);
+    REQUIRE(flow::collect<std::vector>(std::move(names)) == std::vector<std::string>{"Ada", "Tim", "Eve"});
+    REQUIRE(people[0].name == "Ada");
+    REQUIRE(flow::collect<std::vector>(flow::elementsReferenced(people) | flow::parMapUnordered(&Person::isAdult, 2)).size() == 3);
+
+    // Move-only functions are moved into the stage.
+    std::vector<int> xs{1, 2, 3};
+    auto offset = std::make_unique<int>(100);
+    auto shifted = flow::elementsOf(xs)
+        | flow::parMap([offset = std::move(offset)] (int x) { return x + *offset; }, 2);
+    REQUIRE(flow::collect<std::vector>(std::move(shifted)) == std::vector<int>{101, 102, 103});
+
+    // Stages nested in parallel algorithms share their threads.
+    std::vector<long> ones(64, 1);
+    long total = flow::parallelReduce(flow::elementsOf(ones), 0L, [&] (long acc, long x)
+    {
+        return acc + x * flow::sum(flow::elementsOf(ones) | flow::parMap([] (long y) { return 2 * y; }, 4, 4));
+    }, [] (long a, long b) { return a + b; }, flow::ParallelOptions{4, 1});
+    REQUIRE(total == 64 * 128);
+}
+
+TEST_CASE("Range-based for does not copy the pipeline")
+{
+    std::vector<Identifier> ids;
+    ids.reserve(6);
+    for (int i = 0; i < 6; ++i)
+    {
+        ids.emplace_back(i);
+    }
+
+    Identifier::copies = 0;
+    auto even = flow::elements(std::move(ids))
+        | flow::map([] (Identifier id) { return id; })
+        | flow::filter([] (Identifier const &id) { return id.id % 2 == 0; });
+
+    int expected = 0;
+    for (Identifier const &id: even)
+    {
+        REQUIRE(id.id == expected);
+        expected += 2;
+    }
+    REQUIRE(expected == 6);
+    REQUIRE(Identifier::copies == 0);
+
+    // Iterating a temporary flow.
+    int sum = 0;
+    for (int x: flow::successors(1) | flow::take(4))
+    {
+        sum += x;
+    }
+    REQUIRE(sum == 10);
+
+    // An iterator obtained from an rvalue flow owns the sequence.
+    auto iterator = (flow::successors(1) | flow::take(2)).begin();
+    REQUIRE(*iterator == 1);
+    ++iterator;
+    REQUIRE(*iterator == 2);
+}
+
+template<class F, class = void>
+struct HasSpan: std::false_type
+{
+};
+
+template<class F>
+struct HasSpan<F, std::void_t<decltype(std::declval<F const &>().span())>>: std::true_type
+{
+};
+
+template<class F, class = void>
+struct HasView: std::false_type
+{
+};
+
+template<class F>
+struct HasView<F, std::void_t<decltype(std::declval<F const &>().view())>>: std::true_type
+{
+};
+
+TEST_CASE("Standard iterators")
+{
+    std::vector<int> xs = {1, 2, 3, 4, 5, 6};
+
+    auto even = flow::elementsOf(xs) | flow::filter([] (int x) { return x % 2 == 0; });
+    using EvenIterator = decltype(even.begin());
+    static_assert(std::is_same_v<EvenIterator, decltype(even.end())>);
+    static_assert(std::is_same_v<std::iterator_traits<EvenIterator>::iterator_category, std::input_iterator_tag>);
+    static_assert(std::is_same_v<std::iterator_traits<EvenIterator>::value_type, int>);
+
+    REQUIRE(std::vector<int>(even.begin(), even.end()) == std::vector<int>{2, 4, 6});
+
+    auto odd = flow::elementsOf(xs) | flow::filter([] (int x) { return x % 2 == 1; });
+    REQUIRE(std::accumulate(odd.begin(), odd.end(), 0) == 1 + 3 + 5);
+
+    // Post-increment yields the previous element.
+    auto iterator = (flow::elementsOf(xs) | flow::map([] (int x) { return x * 10; })).begin();
+    REQUIRE(*iterator++ == 10);
+    REQUIRE(*iterator == 20);
+    REQUIRE(iterator != flow::EndIterator{});
+    REQUIRE(!(flow::EndIterator{} == iterator));
+
+    // Contiguous flows are iterated like any other flow, consuming their elements.
+    std::vector<int> doubled;
+    for (auto &x: flow::elements(xs))
+    {
+        x *= 2;
+        doubled.push_back(x);
+    }
+    REQUIRE(doubled == std::vector<int>{2, 4, 6, 8, 10, 12});
+
+    auto contiguous = flow::elementsOf(xs);
+    static_assert(std::is_same_v<decltype(contiguous.begin()), decltype(contiguous.end())>);
+    REQUIRE(*contiguous.begin() == 1);
+    REQUIRE(contiguous.next().value() == 2);
+
+    // Their span is viewed by random-access pointers instead.
+    auto span = contiguous.span();
+    REQUIRE(span.end() - span.begin() == 4);
+    REQUIRE(std::lower_bound(span.begin(), span.end(), 4) - span.begin() == 1);
+    REQUIRE(contiguous.next().value() == 3);
+    static_assert(HasSpan<decltype(contiguous)>::value);
+    static_assert(!HasSpan<decltype(even)>::value);
+
+    // Exactly sliceable flows are viewed by random-access iterators computing their elements.
+    auto multiples = flow::range(0, 100, 3);
+    auto view = multiples.view();
+    using ViewIterator = decltype(view.begin());
+    static_assert(std::is_same_v<std::iterator_traits<ViewIterator>::iterator_category, std::random_access_iterator_tag>);
+    REQUIRE(view.end() - view.begin() == 34);
+    REQUIRE(*std::lower_bound(view.begin(), view.end(), 50) == 51);
+    REQUIRE(std::upper_bound(view.begin(), view.end(), 50) - view.begin() == 17);
+    REQUIRE(view[10] == 30);
+    REQUIRE(*(view.end() - 1) == 99);
+    REQUIRE(multiples.next().value() == 0);
+
+    auto bits = flow::randomBits(42, 8);
+    auto randomView = bits.view();
+    REQUIRE(std::vector<uint64_t>(randomView.begin(), randomView.end()) == flow::collect<std::vector>(bits));
+    static_assert(HasView<decltype(contiguous)>::value);
+    static_assert(!HasView<decltype(even)>::value);
+}
+
+TEST_CASE("Range")
+{
+    REQUIRE(flow::collect<std::vector>(flow::range(0, 5)) == std::vector<int>{0, 1, 2, 3, 4});
+    REQUIRE(flow::collect<std::vector>(flow::range(1, 8, 3)) == std::vector<int>{1, 4, 7});
+    REQUIRE(flow::collect<std::vector>(flow::range(10, 0, -2)) == std::vector<int>{10, 8, 6, 4, 2});
+    REQUIRE(flow::collect<std::vector>(flow::range(0.0, 1.0, 0.25)) == std::vector<double>{0.0, 0.25, 0.5, 0.75});
+    REQUIRE(!flow::range(5, 5).next().hasValue());
+    REQUIRE(!flow::range(0, 5, 0).next().hasValue());
+
+    // Infinite and huge floating point ranges are clamped to the largest size.
+    auto unbounded = flow::range(0.0, std::numeric_limits<double>::infinity());
+    REQUIRE(flow::sizeHint(unbounded).lower == std::numeric_limits<size_t>::max());
+    REQUIRE(flow::collect<std::vector>(unbounded | flow::take(3)) == std::vector<double>{0.0, 1.0, 2.0});
+    REQUIRE(flow::sizeHint(flow::range(0.0f, 1e30f)).lower == std::numeric_limits<size_t>::max());
+    REQUIRE(!flow::range(0.0, std::nan("")).next().hasValue());
+
+    std::vector<size_t> indices = {2, 3};
+    static_assert(std::is_same_v<decltype(flow::range(0, indices.size()))::ElementType, size_t>);
+
+    auto numbers = flow::range(-1000000, 1000000, 7);
+    REQUIRE(numbers.sizeHint().lower == 285715);
+    REQUIRE(numbers.sizeHint().upper.value() == 285715);
+    REQUIRE(flow::nth(numbers, 1000).value() == -1000000 + 7 * 1000);
+    REQUIRE(numbers.next().value() == -1000000 + 7 * 1001);
+
+    // Batched, sliced and split like a contiguous sequence.
+    auto squares = flow::range(0, 1000) | flow::map([] (int i) { return i * i; });
+    REQUIRE(flow::sum(squares) == 332833500);
+    REQUIRE(flow::parallelReduce(squares, 0, std::plus<>(), std::plus<>(), {4, 10}) == 332833500);
+    REQUIRE(flow::parallelSum(flow::range(0.0, 1000.0), 3) == 499500.0);
+    auto halves = flow::split(flow::range(0, 10)).value();
+    REQUIRE(flow::collect<std::vector>(halves.second) == std::vector<int>{5, 6, 7, 8, 9});
+
+    // Successors no longer narrow to int.
+    auto large = flow::successors(size_t(1) << 40);
+    static_assert(std::is_same_v<decltype(large)::ElementType, size_t>);
+    REQUIRE(large.next().value() == size_t(1) << 40);
+}
+
+TEST_CASE("Random")
+{
+    // Known answer of Philox4x32-10 for a zero counter and key.
+    REQUIRE(flow::details::philox(0, 0) == flow::details::PhiloxBlock{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+
+    auto bits = flow::randomBits(42, 1000);
+    std::vector<uint64_t> all = flow::collect<std::vector>(bits);
+    REQUIRE(all.size() == 1000);
+    REQUIRE(flow::collect<std::vector>(flow::randomBits(42, 1000)) == all);
+    REQUIRE(flow::collect<std::vector>(flow::randomBits(43, 1000)) != all);
+
+    // Random access and slicing yield the same elements as iterating.
+    REQUIRE(flow::nth(bits, 500).value() == all[500]);
+    REQUIRE(flow::collect<std::vector>(bits.slice(10, 13)) == std::vector<uint64_t>{all[511], all[512], all[513]});
+    auto odd = flow::randomBits(42, 1000);
+    odd.advanceBy(1);
+    uint64_t batch[4];
+    REQUIRE(odd.nextBatch(flow::Span<uint64_t>(batch)) == 4);
+    REQUIRE(std::vector<uint64_t>(batch, batch + 4) == std::vector<uint64_t>{all[1], all[2], all[3], all[4]});
+
+    // Sums do not depend on the number of threads.
+    auto uniform = flow::randomUniform(7, 100000, -1.0, 1.0);
+    double sum = flow::parallelSum(uniform, 1);
+    REQUIRE(flow::parallelSum(uniform, 4) == sum);
+    REQUIRE(std::abs(sum / 100000) < 0.01);
+    REQUIRE(flow::min(uniform).value() >= -1.0);
+    REQUIRE(flow::max(uniform).value() < 1.0);
+    // Half of these would round up to the upper bound.
+    float high = std::nextafter(1.0f, 2.0f);
+    REQUIRE(flow::max(flow::randomUniform(7, 1000, 1.0f, high)).value() < high);
+
+    auto normal = flow::randomNormal<float>(7, 100000, 5.0f, 2.0f);
+    double mean = flow::parallelSum(normal) / 100000;
+    double variance = flow::sum(normal | flow::map([=] (float x) { return (x - mean) * (x - mean); })) / 100000;
+    REQUIRE(std::abs(mean - 5.0) < 0.05);
+    REQUIRE(std::abs(variance - 4.0) < 0.1);
+}